@@ -0,0 +1,495 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "icsreader.h"
+
+#include <QFile>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// A property value. Points into the mapped file unless the content line was
+// folded, then it owns the unfolded copy.
+class RawValue
+{
+public:
+    RawValue() = default;
+    RawValue(QByteArrayView view, const QByteArray &unfolded)
+        : m_view(view)
+        , m_unfolded(unfolded)
+    {
+    }
+
+    QByteArrayView data() const
+    {
+        return m_unfolded.isNull() ? m_view : QByteArrayView(m_unfolded);
+    }
+
+    bool isNull() const
+    {
+        return m_view.isNull() && m_unfolded.isNull();
+    }
+
+private:
+    QByteArrayView m_view;
+    QByteArray m_unfolded;
+};
+
+struct DateTimeProperty {
+    RawValue value;
+    QByteArray tzid;
+    bool isDate = false;
+};
+
+struct Component {
+    CalendarEvents::EventData::EventType type = CalendarEvents::EventData::Event;
+    DateTimeProperty start;
+    DateTimeProperty end;
+    DateTimeProperty due;
+    RawValue duration;
+    RawValue summary;
+    RawValue description;
+    RawValue uid;
+    RawValue color;
+};
+
+bool parseNumber(QByteArrayView digits, int &number)
+{
+    number = 0;
+    for (const char c : digits) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        number = number * 10 + (c - '0');
+    }
+    return !digits.isEmpty();
+}
+
+QDate parseDate(QByteArrayView value)
+{
+    int year;
+    int month;
+    int day;
+    if (value.size() < 8 || !parseNumber(value.first(4), year) || !parseNumber(value.sliced(4, 2), month) || !parseNumber(value.sliced(6, 2), day)) {
+        return QDate();
+    }
+    return QDate(year, month, day);
+}
+
+// DATE (YYYYMMDD) or DATE-TIME (YYYYMMDDTHHMMSS with an optional trailing Z)
+QDateTime parseDateTime(const DateTimeProperty &property)
+{
+    const QByteArrayView value = property.value.data().trimmed();
+
+    const QDate date = parseDate(value);
+    if (!date.isValid()) {
+        return QDateTime();
+    }
+
+    if (property.isDate || value.size() < 15 || value.at(8) != 'T') {
+        return QDateTime(date, QTime(0, 0));
+    }
+
+    int hour;
+    int minute;
+    int second;
+    if (!parseNumber(value.sliced(9, 2), hour) || !parseNumber(value.sliced(11, 2), minute) || !parseNumber(value.sliced(13, 2), second)) {
+        return QDateTime();
+    }
+    // Leap seconds are allowed by the RFC but not by QTime
+    const QTime time(hour, minute, std::min(second, 59));
+
+    if (value.size() > 15 && value.at(15) == 'Z') {
+        return QDateTime(date, time, QTimeZone::utc());
+    }
+
+    if (!property.tzid.isEmpty()) {
+        const QTimeZone timeZone(property.tzid);
+        if (timeZone.isValid()) {
+            return QDateTime(date, time, timeZone);
+        }
+    }
+
+    // Floating time, or a time zone we don't know about
+    return QDateTime(date, time);
+}
+
+// [+-]P(nW | [nD][T[nH][nM][nS]]), in seconds
+bool parseDuration(QByteArrayView value, qint64 &seconds)
+{
+    value = value.trimmed();
+    seconds = 0;
+
+    qint64 sign = 1;
+    if (value.startsWith('-') || value.startsWith('+')) {
+        sign = value.front() == '-' ? -1 : 1;
+        value = value.sliced(1);
+    }
+    if (!value.startsWith('P')) {
+        return false;
+    }
+    value = value.sliced(1);
+
+    qint64 number = 0;
+    bool hasNumber = false;
+    for (const char c : value) {
+        if (c >= '0' && c <= '9') {
+            number = number * 10 + (c - '0');
+            hasNumber = true;
+            continue;
+        }
+
+        qint64 unit = 0;
+        switch (c) {
+        case 'W':
+            unit = 7 * 24 * 3600;
+            break;
+        case 'D':
+            unit = 24 * 3600;
+            break;
+        case 'H':
+            unit = 3600;
+            break;
+        case 'M':
+            unit = 60;
+            break;
+        case 'S':
+            unit = 1;
+            break;
+        case 'T':
+            continue;
+        default:
+            return false;
+        }
+
+        if (!hasNumber) {
+            return false;
+        }
+        seconds += number * unit;
+        number = 0;
+        hasNumber = false;
+    }
+
+    seconds *= sign;
+    return !hasNumber;
+}
+
+// Removes the TEXT escaping of RFC 5545 section 3.3.11
+QString decodeText(const RawValue &raw)
+{
+    const QByteArrayView value = raw.data();
+    if (!value.contains('\\')) {
+        return QString::fromUtf8(value);
+    }
+
+    QByteArray unescaped;
+    unescaped.reserve(value.size());
+    for (qsizetype i = 0; i < value.size(); ++i) {
+        const char c = value.at(i);
+        if (c != '\\' || i + 1 == value.size()) {
+            unescaped.append(c);
+            continue;
+        }
+
+        const char escaped = value.at(++i);
+        unescaped.append(escaped == 'n' || escaped == 'N' ? '\n' : escaped);
+    }
+    return QString::fromUtf8(unescaped);
+}
+
+class IcsTokenizer
+{
+public:
+    IcsTokenizer(QByteArrayView data, const QDate &startDate, const QDate &endDate, const CalendarEvents::IcsReader::EventCallback &callback)
+        : m_data(data)
+        , m_startDate(startDate)
+        , m_endDate(endDate)
+        , m_callback(callback)
+    {
+    }
+
+    void run();
+
+private:
+    void handleLine(QByteArrayView line, bool folded);
+    void finishComponent();
+
+    const QByteArrayView m_data;
+    const QDate m_startDate;
+    const QDate m_endDate;
+    const CalendarEvents::IcsReader::EventCallback &m_callback;
+
+    bool m_inComponent = false;
+    // Depth of subcomponents (e.g. VALARM) inside the current VEVENT/VTODO, their properties are ignored
+    int m_nestedDepth = 0;
+    Component m_component;
+    QByteArray m_unfolded;
+};
+
+void IcsTokenizer::run()
+{
+    const char *const begin = m_data.data();
+    const qsizetype size = m_data.size();
+
+    qsizetype pos = 0;
+    while (pos < size) {
+        // Find the end of the content line, following folded continuation lines
+        qsizetype end = pos;
+        bool folded = false;
+        while (true) {
+            const void *newline = std::memchr(begin + end, '\n', size - end);
+            if (!newline) {
+                end = size;
+                break;
+            }
+            end = static_cast<const char *>(newline) - begin;
+            if (end + 1 < size && (begin[end + 1] == ' ' || begin[end + 1] == '\t')) {
+                folded = true;
+                ++end;
+                continue;
+            }
+            break;
+        }
+
+        qsizetype lineEnd = end;
+        if (lineEnd > pos && begin[lineEnd - 1] == '\r') {
+            --lineEnd;
+        }
+        if (lineEnd > pos) {
+            handleLine(QByteArrayView(begin + pos, lineEnd - pos), folded);
+        }
+        pos = end + 1;
+    }
+}
+
+void IcsTokenizer::handleLine(QByteArrayView line, bool folded)
+{
+    // Outside of VEVENT and VTODO only BEGIN lines matter, skip everything else without unfolding or splitting it
+    if (!m_inComponent && (line.size() < 6 || line.first(6).compare("BEGIN:", Qt::CaseInsensitive) != 0)) {
+        return;
+    }
+
+    if (folded) {
+        m_unfolded.clear();
+        m_unfolded.reserve(line.size());
+        for (qsizetype i = 0; i < line.size(); ++i) {
+            const char c = line.at(i);
+            if (c == '\r' && i + 1 < line.size() && line.at(i + 1) == '\n') {
+                continue;
+            }
+            if (c == '\n') {
+                // Drop the newline and the single whitespace character starting the continuation line
+                ++i;
+                continue;
+            }
+            m_unfolded.append(c);
+        }
+        line = m_unfolded;
+    }
+
+    // NAME *(";" PARAM) ":" VALUE, colons inside quoted parameter values don't count
+    qsizetype valueStart = -1;
+    bool quoted = false;
+    for (qsizetype i = 0; i < line.size(); ++i) {
+        const char c = line.at(i);
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (c == ':' && !quoted) {
+            valueStart = i + 1;
+            break;
+        }
+    }
+    if (valueStart < 0) {
+        return;
+    }
+
+    const QByteArrayView nameAndParams = line.first(valueStart - 1);
+    const qsizetype paramsStart = nameAndParams.indexOf(';');
+    const QByteArrayView name = paramsStart < 0 ? nameAndParams : nameAndParams.first(paramsStart);
+    const QByteArrayView value = line.sliced(valueStart);
+
+    if (name.compare("BEGIN", Qt::CaseInsensitive) == 0) {
+        if (m_inComponent) {
+            ++m_nestedDepth;
+        } else if (value.compare("VEVENT", Qt::CaseInsensitive) == 0 || value.compare("VTODO", Qt::CaseInsensitive) == 0) {
+            m_inComponent = true;
+            m_nestedDepth = 0;
+            m_component = Component();
+            m_component.type = value.compare("VTODO", Qt::CaseInsensitive) == 0 ? CalendarEvents::EventData::Todo : CalendarEvents::EventData::Event;
+        }
+        return;
+    }
+
+    if (!m_inComponent) {
+        return;
+    }
+
+    if (name.compare("END", Qt::CaseInsensitive) == 0) {
+        if (m_nestedDepth > 0) {
+            --m_nestedDepth;
+        } else {
+            finishComponent();
+            m_inComponent = false;
+        }
+        return;
+    }
+
+    if (m_nestedDepth > 0) {
+        return;
+    }
+
+    // Only the unfolded buffer is reused between lines, everything else stays valid while the data is mapped
+    const RawValue raw(folded ? QByteArrayView() : value, folded ? value.toByteArray() : QByteArray());
+
+    const auto dateTimeProperty = [&]() {
+        DateTimeProperty property;
+        property.value = raw;
+
+        QByteArrayView params = paramsStart < 0 ? QByteArrayView() : nameAndParams.sliced(paramsStart + 1);
+        while (!params.isEmpty()) {
+            const qsizetype separator = params.indexOf(';');
+            const QByteArrayView param = separator < 0 ? params : params.first(separator);
+            params = separator < 0 ? QByteArrayView() : params.sliced(separator + 1);
+
+            const qsizetype equals = param.indexOf('=');
+            if (equals < 0) {
+                continue;
+            }
+            const QByteArrayView paramName = param.first(equals);
+            QByteArrayView paramValue = param.sliced(equals + 1);
+            if (paramValue.size() >= 2 && paramValue.startsWith('"') && paramValue.endsWith('"')) {
+                paramValue = paramValue.sliced(1, paramValue.size() - 2);
+            }
+
+            if (paramName.compare("VALUE", Qt::CaseInsensitive) == 0) {
+                property.isDate = paramValue.compare("DATE", Qt::CaseInsensitive) == 0;
+            } else if (paramName.compare("TZID", Qt::CaseInsensitive) == 0) {
+                property.tzid = paramValue.toByteArray();
+            }
+        }
+        return property;
+    };
+
+    if (name.compare("DTSTART", Qt::CaseInsensitive) == 0) {
+        m_component.start = dateTimeProperty();
+    } else if (name.compare("DTEND", Qt::CaseInsensitive) == 0) {
+        m_component.end = dateTimeProperty();
+    } else if (name.compare("DUE", Qt::CaseInsensitive) == 0) {
+        m_component.due = dateTimeProperty();
+    } else if (name.compare("DURATION", Qt::CaseInsensitive) == 0) {
+        m_component.duration = raw;
+    } else if (name.compare("SUMMARY", Qt::CaseInsensitive) == 0) {
+        m_component.summary = raw;
+    } else if (name.compare("DESCRIPTION", Qt::CaseInsensitive) == 0) {
+        m_component.description = raw;
+    } else if (name.compare("UID", Qt::CaseInsensitive) == 0) {
+        m_component.uid = raw;
+    } else if (name.compare("COLOR", Qt::CaseInsensitive) == 0) {
+        m_component.color = raw;
+    }
+}
+
+void IcsTokenizer::finishComponent()
+{
+    const bool isTodo = m_component.type == CalendarEvents::EventData::Todo;
+
+    const DateTimeProperty &startProperty = !m_component.start.value.isNull() || !isTodo ? m_component.start : m_component.due;
+    QDateTime start = parseDateTime(startProperty);
+    if (!start.isValid()) {
+        return;
+    }
+    const bool isAllDay = startProperty.isDate;
+
+    QDateTime end;
+    qint64 durationSeconds = 0;
+    if (isTodo) {
+        end = m_component.due.value.isNull() ? start : parseDateTime(m_component.due);
+    } else if (!m_component.end.value.isNull()) {
+        end = parseDateTime(m_component.end);
+        if (isAllDay) {
+            // DTEND of all-day events is exclusive, EventData expects the last day
+            end = end.addDays(-1);
+        }
+    } else if (!m_component.duration.isNull() && parseDuration(m_component.duration.data(), durationSeconds)) {
+        end = start.addSecs(durationSeconds);
+        if (isAllDay) {
+            end = end.addDays(-1);
+        }
+    } else {
+        end = start;
+    }
+    if (!end.isValid() || end < start) {
+        end = start;
+    }
+
+    const QDate startDate = isAllDay ? start.date() : start.toLocalTime().date();
+    const QDate endDate = isAllDay ? end.date() : end.toLocalTime().date();
+    if (startDate > m_endDate || endDate < m_startDate) {
+        return;
+    }
+
+    // Only now that the component is known to be in range are its texts decoded
+    CalendarEvents::EventData event;
+    event.setEventType(m_component.type);
+    event.setStartDateTime(start);
+    event.setEndDateTime(end);
+    event.setIsAllDay(isAllDay && startDate == endDate);
+    event.setIsMinor(false);
+    event.setTitle(decodeText(m_component.summary));
+    event.setDescription(decodeText(m_component.description));
+    event.setUid(decodeText(m_component.uid));
+    event.setEventColor(decodeText(m_component.color));
+
+    m_callback(startDate, event);
+}
+}
+
+namespace CalendarEvents
+{
+namespace IcsReader
+{
+void readEvents(QByteArrayView data, const QDate &startDate, const QDate &endDate, const EventCallback &callback)
+{
+    IcsTokenizer tokenizer(data, startDate, endDate, callback);
+    tokenizer.run();
+}
+
+bool readEvents(const QString &fileName, const QDate &startDate, const QDate &endDate, const EventCallback &callback)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    if (file.size() == 0) {
+        return true;
+    }
+
+    // The mapping is released when the file is destroyed
+    if (const uchar *mapped = file.map(0, file.size())) {
+        readEvents(QByteArrayView(mapped, file.size()), startDate, endDate, callback);
+        return true;
+    }
+
+    // Not mappable, e.g. a pipe or some virtual file system
+    const QByteArray data = file.readAll();
+    readEvents(QByteArrayView(data), startDate, endDate, callback);
+    return true;
+}
+
+QMultiHash<QDate, EventData> readEvents(const QString &fileName, const QDate &startDate, const QDate &endDate)
+{
+    QMultiHash<QDate, EventData> events;
+    readEvents(fileName, startDate, endDate, [&events](const QDate &date, const EventData &event) {
+        events.insert(date, event);
+    });
+    return events;
+}
+}
+}
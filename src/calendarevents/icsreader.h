@@ -0,0 +1,79 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef ICSREADER_H
+#define ICSREADER_H
+
+#include <QByteArrayView>
+#include <QDate>
+#include <QMultiHash>
+#include <QString>
+
+#include <functional>
+
+#include "calendarevents_export.h"
+#include "calendareventsplugin.h"
+
+namespace CalendarEvents
+{
+/**
+ * @namespace CalendarEvents::IcsReader icsreader.h <CalendarEvents/IcsReader>
+ *
+ * A streaming reader for iCalendar (RFC 5545) files.
+ *
+ * This is meant for simple CalendarEventsPlugin implementations that show the
+ * events of local .ics files. Instead of building an object model of the whole
+ * calendar and converting it to EventData afterwards, the file is memory mapped
+ * and tokenized in a single pass. VEVENT and VTODO components are converted to
+ * EventData directly, and only if they intersect the requested date range; the
+ * text properties of all other components are never decoded. This keeps loading
+ * a single month cheap even for very large exported calendars.
+ *
+ * Recurrence rules are not expanded, recurring events are only reported for their
+ * first occurrence. Time zones referenced with TZID are resolved with QTimeZone,
+ * unknown ones fall back to local time.
+ *
+ * @code
+ * void MyPlugin::loadEventsForDateRange(const QDate &startDate, const QDate &endDate)
+ * {
+ *     Q_EMIT dataReady(CalendarEvents::IcsReader::readEvents(m_fileName, startDate, endDate));
+ * }
+ * @endcode
+ *
+ * @since 6.0
+ */
+namespace IcsReader
+{
+/**
+ * Called for every event intersecting the requested date range
+ *
+ * @param date The date the event should be keyed with in CalendarEventsPlugin::dataReady(),
+ *             i.e. the date it starts on
+ * @param event The event
+ */
+using EventCallback = std::function<void(const QDate &date, const CalendarEvents::EventData &event)>;
+
+/**
+ * Reads the events between @p startDate and @p endDate from the iCalendar file @p fileName
+ *
+ * @return false if the file could not be opened
+ */
+CALENDAREVENTS_EXPORT bool readEvents(const QString &fileName, const QDate &startDate, const QDate &endDate, const EventCallback &callback);
+
+/**
+ * Reads the events between @p startDate and @p endDate from the iCalendar data @p data
+ */
+CALENDAREVENTS_EXPORT void readEvents(QByteArrayView data, const QDate &startDate, const QDate &endDate, const EventCallback &callback);
+
+/**
+ * Convenience overload collecting the events in the form expected by CalendarEventsPlugin::dataReady()
+ */
+CALENDAREVENTS_EXPORT QMultiHash<QDate, CalendarEvents::EventData> readEvents(const QString &fileName, const QDate &startDate, const QDate &endDate);
+}
+
+}
+
+#endif
@@ -0,0 +1,483 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "sharedeventsnapshot.h"
+
+#include <QAtomicInteger>
+#include <QCoreApplication>
+#include <QHash>
+#include <QSharedMemory>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <signal.h>
+#endif
+
+namespace
+{
+// "CEVS", bump SnapshotVersion whenever the layout below changes
+constexpr quint32 SnapshotMagic = 0x43455653;
+constexpr quint32 SnapshotVersion = 2;
+
+enum RecordFlag : quint8 {
+    AllDay = 0x01,
+    Minor = 0x02,
+    StartLocalTime = 0x04,
+    EndLocalTime = 0x08,
+    StartValid = 0x10,
+    EndValid = 0x20,
+};
+
+// A string in the string table, offset and length are in UTF-16 code units
+struct StringRef {
+    quint32 offset;
+    quint32 length;
+};
+
+// Everything in the segment is addressed relative to its start, so the segment
+// can be mapped at any address in any process.
+struct SnapshotHeader {
+    quint32 magic;
+    quint32 version;
+    QBasicAtomicInteger<quint64> sequence;
+    qint64 startJulianDay;
+    qint64 endJulianDay;
+    quint32 recordCount;
+    quint32 recordsOffset; // in bytes
+    quint32 stringsOffset; // in bytes
+    quint32 stringsLength; // in UTF-16 code units
+    qint64 ownerPid; // 0 once the owner released the segment
+};
+
+struct SnapshotRecord {
+    qint64 dayJulianDay;
+    qint64 startMSecs;
+    qint64 endMSecs;
+    qint32 startOffsetSeconds;
+    qint32 endOffsetSeconds;
+    StringRef startZone;
+    StringRef endZone;
+    StringRef title;
+    StringRef description;
+    StringRef uid;
+    StringRef eventColor;
+    quint8 type;
+    quint8 flags;
+};
+
+constexpr qsizetype alignedSize(qsizetype size)
+{
+    return (size + alignof(SnapshotRecord) - 1) & ~qsizetype(alignof(SnapshotRecord) - 1);
+}
+
+class StringTableWriter
+{
+public:
+    StringRef add(const QString &string)
+    {
+        if (string.isEmpty()) {
+            return {0, 0};
+        }
+
+        // Uids and colors repeat a lot, only store them once
+        auto it = m_offsets.constFind(string);
+        if (it != m_offsets.constEnd()) {
+            return {*it, quint32(string.size())};
+        }
+
+        const quint32 offset = m_strings.size();
+        m_strings.append(string);
+        m_offsets.insert(string, offset);
+        return {offset, quint32(string.size())};
+    }
+
+    const QString &strings() const
+    {
+        return m_strings;
+    }
+
+private:
+    QString m_strings;
+    QHash<QString, quint32> m_offsets;
+};
+
+void storeDateTime(const QDateTime &dateTime, qint64 &msecs, qint32 &offsetSeconds, StringRef &zone, quint8 &flags, RecordFlag valid, RecordFlag local, StringTableWriter &strings)
+{
+    msecs = 0;
+    offsetSeconds = 0;
+    zone = {0, 0};
+
+    if (!dateTime.isValid()) {
+        return;
+    }
+
+    flags |= valid;
+    msecs = dateTime.toMSecsSinceEpoch();
+    offsetSeconds = dateTime.offsetFromUtc();
+
+    switch (dateTime.timeSpec()) {
+    case Qt::LocalTime:
+        flags |= local;
+        break;
+    case Qt::TimeZone:
+        zone = strings.add(QString::fromUtf8(dateTime.timeZone().id()));
+        break;
+    case Qt::UTC:
+    case Qt::OffsetFromUTC:
+        break;
+    }
+}
+
+// Whether the owner recorded in a segment is still around, or crashed without releasing it
+bool isProcessRunning(qint64 pid)
+{
+#ifdef Q_OS_WIN
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, DWORD(pid));
+    if (!process) {
+        return false;
+    }
+    const bool running = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return running;
+#else
+    return kill(pid_t(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+QDateTime loadDateTime(qint64 msecs, qint32 offsetSeconds, const QString &zone, quint8 flags, RecordFlag valid, RecordFlag local)
+{
+    if (!(flags & valid)) {
+        return QDateTime();
+    }
+
+    if (flags & local) {
+        return QDateTime::fromMSecsSinceEpoch(msecs);
+    }
+
+    if (!zone.isEmpty()) {
+        const QTimeZone timeZone(zone.toUtf8());
+        if (timeZone.isValid()) {
+            return QDateTime::fromMSecsSinceEpoch(msecs, timeZone);
+        }
+    }
+
+    return QDateTime::fromMSecsSinceEpoch(msecs, QTimeZone::fromSecondsAheadOfUtc(offsetSeconds));
+}
+}
+
+namespace CalendarEvents
+{
+class SharedEventSnapshotPrivate
+{
+public:
+    SharedEventSnapshotPrivate(const QString &key, SharedEventSnapshot::Role role, qsizetype capacity)
+        : key(key)
+        , role(role)
+        , capacity(capacity)
+        , memory(key)
+    {
+    }
+
+    using EventVisitor = std::function<void(const QDate &day, const EventData &event)>;
+
+    bool attach();
+    const SnapshotHeader *header() const;
+    quint64 visit(const EventVisitor &visitor, QDate *startDate, QDate *endDate);
+
+    const QString key;
+    const SharedEventSnapshot::Role role;
+    const qsizetype capacity;
+    QSharedMemory memory;
+    QString errorString;
+};
+
+bool SharedEventSnapshotPrivate::attach()
+{
+    if (memory.isAttached()) {
+        return true;
+    }
+
+    if (role == SharedEventSnapshot::Reader) {
+        if (!memory.attach(QSharedMemory::ReadOnly)) {
+            errorString = memory.errorString();
+            return false;
+        }
+        return true;
+    }
+
+    const qsizetype size = std::max<qsizetype>(capacity, sizeof(SnapshotHeader));
+
+    if (!memory.create(size)) {
+        // A previous owner may have crashed without releasing the segment, reuse it
+        if (memory.error() != QSharedMemory::AlreadyExists || !memory.attach(QSharedMemory::ReadWrite)) {
+            errorString = memory.errorString();
+            return false;
+        }
+    }
+
+    if (!memory.lock()) {
+        errorString = memory.errorString();
+        memory.detach();
+        return false;
+    }
+
+    auto *header = static_cast<SnapshotHeader *>(memory.data());
+    if (header->magic != SnapshotMagic || header->version != SnapshotVersion) {
+        std::memset(memory.data(), 0, memory.size());
+        header->magic = SnapshotMagic;
+        header->version = SnapshotVersion;
+    } else if (header->ownerPid != 0 && isProcessRunning(header->ownerPid)) {
+        // Never reset the batch of another live owner, publish() tries again once it's gone
+        errorString = QStringLiteral("The shared memory segment is already owned by process %1").arg(header->ownerPid);
+        memory.unlock();
+        memory.detach();
+        return false;
+    }
+    header->ownerPid = QCoreApplication::applicationPid();
+    // An empty batch until the first publish(), but keep the sequence monotonic for readers
+    header->recordCount = 0;
+    header->stringsLength = 0;
+    header->startJulianDay = 0;
+    header->endJulianDay = 0;
+
+    memory.unlock();
+    return true;
+}
+
+const SnapshotHeader *SharedEventSnapshotPrivate::header() const
+{
+    const auto *header = static_cast<const SnapshotHeader *>(memory.constData());
+    if (!header || memory.size() < qsizetype(sizeof(SnapshotHeader)) || header->magic != SnapshotMagic || header->version != SnapshotVersion) {
+        return nullptr;
+    }
+    return header;
+}
+
+SharedEventSnapshot::SharedEventSnapshot(const QString &key, Role role, qsizetype capacity)
+    : d(new SharedEventSnapshotPrivate(key, role, capacity))
+{
+    d->attach();
+}
+
+SharedEventSnapshot::~SharedEventSnapshot()
+{
+    if (d->role != Owner || !d->memory.isAttached() || !d->memory.lock()) {
+        return;
+    }
+
+    // Readers keep the published batch, but the next owner can take the segment over
+    auto *header = static_cast<SnapshotHeader *>(d->memory.data());
+    if (header->ownerPid == QCoreApplication::applicationPid()) {
+        header->ownerPid = 0;
+    }
+    d->memory.unlock();
+}
+
+QString SharedEventSnapshot::key() const
+{
+    return d->key;
+}
+
+SharedEventSnapshot::Role SharedEventSnapshot::role() const
+{
+    return d->role;
+}
+
+bool SharedEventSnapshot::isValid() const
+{
+    return d->memory.isAttached();
+}
+
+bool SharedEventSnapshot::publish(const QMultiHash<QDate, EventData> &data, const QDate &startDate, const QDate &endDate)
+{
+    if (d->role != Owner) {
+        d->errorString = QStringLiteral("Only the owner can publish events");
+        return false;
+    }
+
+    if (!d->attach()) {
+        return false;
+    }
+
+    // Serialize outside of the lock, readers only wait for the memcpy below
+    StringTableWriter strings;
+    QList<SnapshotRecord> records;
+    records.reserve(data.size());
+
+    for (auto it = data.constBegin(); it != data.constEnd(); ++it) {
+        const EventData &event = it.value();
+
+        SnapshotRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.dayJulianDay = it.key().toJulianDay();
+        record.type = event.type();
+        record.flags = quint8((event.isAllDay() ? AllDay : 0) | (event.isMinor() ? Minor : 0));
+        storeDateTime(event.startDateTime(), record.startMSecs, record.startOffsetSeconds, record.startZone, record.flags, StartValid, StartLocalTime, strings);
+        storeDateTime(event.endDateTime(), record.endMSecs, record.endOffsetSeconds, record.endZone, record.flags, EndValid, EndLocalTime, strings);
+        record.title = strings.add(event.title());
+        record.description = strings.add(event.description());
+        record.uid = strings.add(event.uid());
+        record.eventColor = strings.add(event.eventColor());
+        records.append(record);
+    }
+
+    const qsizetype recordsOffset = alignedSize(sizeof(SnapshotHeader));
+    const qsizetype stringsOffset = alignedSize(recordsOffset + records.size() * sizeof(SnapshotRecord));
+    const qsizetype totalSize = stringsOffset + strings.strings().size() * sizeof(char16_t);
+
+    if (totalSize > d->memory.size()) {
+        d->errorString = QStringLiteral("%1 events need %2 bytes, but the shared memory segment only has %3").arg(data.size()).arg(totalSize).arg(d->memory.size());
+        return false;
+    }
+
+    if (!d->memory.lock()) {
+        d->errorString = d->memory.errorString();
+        return false;
+    }
+
+    char *base = static_cast<char *>(d->memory.data());
+    auto *header = reinterpret_cast<SnapshotHeader *>(base);
+
+    std::memcpy(base + recordsOffset, records.constData(), records.size() * sizeof(SnapshotRecord));
+    std::memcpy(base + stringsOffset, strings.strings().constData(), strings.strings().size() * sizeof(char16_t));
+
+    header->startJulianDay = startDate.toJulianDay();
+    header->endJulianDay = endDate.toJulianDay();
+    header->recordCount = records.size();
+    header->recordsOffset = recordsOffset;
+    header->stringsOffset = stringsOffset;
+    header->stringsLength = strings.strings().size();
+    header->sequence.storeRelease(header->sequence.loadRelaxed() + 1);
+
+    d->memory.unlock();
+    return true;
+}
+
+quint64 SharedEventSnapshot::sequence() const
+{
+    if (!d->attach()) {
+        return 0;
+    }
+
+    const SnapshotHeader *header = d->header();
+    return header ? header->sequence.loadAcquire() : 0;
+}
+
+quint64 SharedEventSnapshotPrivate::visit(const EventVisitor &visitor, QDate *startDate, QDate *endDate)
+{
+    if (!attach()) {
+        return 0;
+    }
+
+    if (!memory.lock()) {
+        errorString = memory.errorString();
+        return 0;
+    }
+
+    const SnapshotHeader *header = this->header();
+    if (!header) {
+        errorString = QStringLiteral("The shared memory segment does not contain an event snapshot");
+        memory.unlock();
+        return 0;
+    }
+
+    // The segment may have been written by anyone, never trust the header. The
+    // sums are computed in 64 bits so they can't overflow.
+    const quint64 size = memory.size();
+    const quint64 recordsEnd = quint64(header->recordsOffset) + quint64(header->recordCount) * sizeof(SnapshotRecord);
+    const quint64 stringsEnd = quint64(header->stringsOffset) + quint64(header->stringsLength) * sizeof(char16_t);
+    if (header->recordsOffset < sizeof(SnapshotHeader) || header->recordsOffset % alignof(SnapshotRecord) || recordsEnd > size
+        || header->stringsOffset < sizeof(SnapshotHeader) || header->stringsOffset % alignof(char16_t) || stringsEnd > size) {
+        errorString = QStringLiteral("The event snapshot header is corrupt: %1 records at %2 and %3 characters at %4 do not fit into %5 bytes")
+                          .arg(header->recordCount)
+                          .arg(header->recordsOffset)
+                          .arg(header->stringsLength)
+                          .arg(header->stringsOffset)
+                          .arg(size);
+        memory.unlock();
+        return 0;
+    }
+
+    // Viewed in place, only the strings of the event being visited are copied
+    const char *base = static_cast<const char *>(memory.constData());
+    const auto *records = reinterpret_cast<const SnapshotRecord *>(base + header->recordsOffset);
+    const QStringView strings(reinterpret_cast<const char16_t *>(base + header->stringsOffset), header->stringsLength);
+
+    const auto isValidRef = [strings](const StringRef &ref) {
+        return quint64(ref.offset) + ref.length <= quint64(strings.size());
+    };
+    const auto string = [strings](const StringRef &ref) {
+        return ref.length ? strings.mid(ref.offset, ref.length).toString() : QString();
+    };
+
+    const quint64 sequence = header->sequence.loadRelaxed();
+    if (startDate) {
+        *startDate = QDate::fromJulianDay(header->startJulianDay);
+    }
+    if (endDate) {
+        *endDate = QDate::fromJulianDay(header->endJulianDay);
+    }
+
+    for (quint32 i = 0; i < header->recordCount; ++i) {
+        const SnapshotRecord &record = records[i];
+
+        if (!isValidRef(record.startZone) || !isValidRef(record.endZone) || !isValidRef(record.title) || !isValidRef(record.description)
+            || !isValidRef(record.uid) || !isValidRef(record.eventColor)) {
+            errorString = QStringLiteral("Record %1 of the event snapshot references strings outside of the string table").arg(i);
+            memory.unlock();
+            return 0;
+        }
+
+        EventData event;
+        event.setEventType(static_cast<EventData::EventType>(record.type));
+        event.setIsAllDay(record.flags & AllDay);
+        event.setIsMinor(record.flags & Minor);
+        event.setStartDateTime(loadDateTime(record.startMSecs, record.startOffsetSeconds, string(record.startZone), record.flags, StartValid, StartLocalTime));
+        event.setEndDateTime(loadDateTime(record.endMSecs, record.endOffsetSeconds, string(record.endZone), record.flags, EndValid, EndLocalTime));
+        event.setTitle(string(record.title));
+        event.setDescription(string(record.description));
+        event.setUid(string(record.uid));
+        event.setEventColor(string(record.eventColor));
+        visitor(QDate::fromJulianDay(record.dayJulianDay), event);
+    }
+
+    memory.unlock();
+    return sequence;
+}
+
+quint64 SharedEventSnapshot::forEachEvent(const std::function<void(const QDate &day, const EventData &event)> &visitor) const
+{
+    return d->visit(visitor, nullptr, nullptr);
+}
+
+SharedEventSnapshot::Batch SharedEventSnapshot::read() const
+{
+    Batch batch;
+    batch.sequence = d->visit(
+        [&batch](const QDate &day, const EventData &event) {
+            batch.data.insert(day, event);
+        },
+        &batch.startDate,
+        &batch.endDate);
+
+    if (batch.sequence == 0) {
+        return Batch();
+    }
+    return batch;
+}
+
+QString SharedEventSnapshot::errorString() const
+{
+    return d->errorString;
+}
+
+}
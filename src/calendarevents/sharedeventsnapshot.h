@@ -0,0 +1,161 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef SHAREDEVENTSNAPSHOT_H
+#define SHAREDEVENTSNAPSHOT_H
+
+#include <QDate>
+#include <QMultiHash>
+#include <QString>
+
+#include <functional>
+#include <memory>
+
+#include "calendarevents_export.h"
+#include "calendareventsplugin.h"
+
+namespace CalendarEvents
+{
+class SharedEventSnapshotPrivate;
+
+/**
+ * @class SharedEventSnapshot sharedeventsnapshot.h <CalendarEvents/SharedEventSnapshot>
+ *
+ * Shares the events loaded by CalendarEventsPlugin instances between processes.
+ *
+ * Several processes usually load the same plugins for the same months, e.g. the
+ * panel clock, the calendar applet and the notification daemon. With a
+ * SharedEventSnapshot one of them, the Owner, publishes the events it received
+ * through CalendarEventsPlugin::dataReady() into a shared memory segment and the
+ * other hosts, the Readers, read them from that segment instead of loading the
+ * plugins and querying their backends themselves.
+ *
+ * forEachEvent() decodes the events one at a time straight from the segment, so
+ * a reader only holds the events it decides to keep. read() is a convenience
+ * that keeps all of them in a QMultiHash owned by the caller.
+ *
+ * Every published batch is immutable and stored in a position independent layout
+ * (fixed size records referencing a string table by offset), so it can be mapped
+ * at any address. The sequence number increases with every publish(); readers
+ * can poll sequence(), which is a single atomic load, to find out whether they
+ * need to read() again.
+ *
+ * @code
+ * // in the owner
+ * SharedEventSnapshot snapshot(QStringLiteral("plasma-calendar-events"), SharedEventSnapshot::Owner);
+ * connect(plugin, &CalendarEventsPlugin::dataReady, this, [&](const QMultiHash<QDate, EventData> &data) {
+ *     snapshot.publish(data, startDate, endDate);
+ * });
+ *
+ * // in a reader
+ * SharedEventSnapshot snapshot(QStringLiteral("plasma-calendar-events"));
+ * if (snapshot.sequence() != m_lastSequence) {
+ *     m_lastSequence = snapshot.forEachEvent([&](const QDate &day, const EventData &event) {
+ *         if (day == m_visibleDay) {
+ *             m_events.append(event);
+ *         }
+ *     });
+ * }
+ * @endcode
+ *
+ * @since 6.0
+ */
+class CALENDAREVENTS_EXPORT SharedEventSnapshot
+{
+public:
+    enum Role {
+        Owner, /**< Creates the segment and publishes batches into it */
+        Reader, /**< Attaches to an existing segment read-only */
+    };
+
+    /**
+     * A batch of events as published by the owner
+     */
+    struct Batch {
+        quint64 sequence = 0; /**< The sequence number of this batch, 0 if nothing was published yet */
+        QDate startDate; /**< The start of the date range the events were loaded for */
+        QDate endDate; /**< The end of the date range the events were loaded for */
+        QMultiHash<QDate, EventData> data; /**< The events, keyed like in CalendarEventsPlugin::dataReady() */
+    };
+
+    /**
+     * @param key The name of the shared memory segment, all hosts that want to share
+     *            events have to use the same key
+     * @param role Whether this instance publishes or reads batches
+     * @param capacity The size of the segment in bytes, only used by the owner
+     */
+    explicit SharedEventSnapshot(const QString &key, Role role = Reader, qsizetype capacity = 4 * 1024 * 1024);
+    ~SharedEventSnapshot();
+
+    QString key() const;
+    Role role() const;
+
+    /**
+     * Whether the shared memory segment could be created (Owner) or attached (Reader)
+     *
+     * Readers retry attaching on every call to sequence() or read(), so the owner
+     * may be started after them.
+     *
+     * There is only one owner per key: another owner fails while the first one
+     * is alive, and retries on every call to publish().
+     */
+    bool isValid() const;
+
+    /**
+     * Replaces the published batch with @p data
+     *
+     * Only the owner can publish.
+     *
+     * @param data The events as emitted by CalendarEventsPlugin::dataReady()
+     * @param startDate The start of the date range the events were loaded for
+     * @param endDate The end of the date range the events were loaded for
+     * @return true on success, false if this is not the owner or the batch does not fit into the segment
+     */
+    bool publish(const QMultiHash<QDate, EventData> &data, const QDate &startDate, const QDate &endDate);
+
+    /**
+     * The sequence number of the currently published batch, 0 if there is none
+     */
+    quint64 sequence() const;
+
+    /**
+     * Calls @p visitor for every event of the currently published batch
+     *
+     * The events are decoded from the shared memory segment one at a time
+     * while it is locked, so @p visitor should be quick and must not use this
+     * SharedEventSnapshot, nor any other one of the same key.
+     *
+     * Stops and sets errorString() on the first invalid record, after
+     * @p visitor has seen the valid ones before it.
+     *
+     * @return The sequence number of the visited batch, 0 if nothing was published
+     *         yet or the segment doesn't contain a valid snapshot
+     */
+    quint64 forEachEvent(const std::function<void(const QDate &day, const EventData &event)> &visitor) const;
+
+    /**
+     * Copies the currently published batch out of the shared memory segment
+     *
+     * Returns an empty batch and sets errorString() if the segment doesn't
+     * contain a valid snapshot, e.g. because it is too small or was written by
+     * something else.
+     */
+    Batch read() const;
+
+    /**
+     * A human readable description of the last error
+     */
+    QString errorString() const;
+
+private:
+    Q_DISABLE_COPY(SharedEventSnapshot)
+
+    std::unique_ptr<SharedEventSnapshotPrivate> const d;
+};
+
+}
+
+#endif
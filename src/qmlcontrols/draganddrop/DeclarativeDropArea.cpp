@@ -39,6 +39,16 @@ void DeclarativeDropArea::dragEnterEvent(QDragEnterEvent *event)
         return;
     }
 
+    if (!isInsideMask(event->position())) {
+        event->ignore();
+        return;
+    }
+
+    enter(event);
+}
+
+void DeclarativeDropArea::enter(QDragMoveEvent *event)
+{
     DeclarativeDragDropEvent dde(event, this);
     event->accept();
 
@@ -57,14 +67,19 @@ void DeclarativeDropArea::dragEnterEvent(QDragEnterEvent *event)
 }
 
 void DeclarativeDropArea::dragLeaveEvent(QDragLeaveEvent *event)
+{
+    DeclarativeDragDropEvent dde(event, this);
+    leave(&dde);
+}
+
+void DeclarativeDropArea::leave(DeclarativeDragDropEvent *event)
 {
     // do it anyways, in the unlikely case m_preventStealing
     // was changed while drag
     temporaryInhibitParent(false);
 
     m_oldDragMovePos = QPoint(-1, -1);
-    DeclarativeDragDropEvent dde(event, this);
-    Q_EMIT dragLeave(&dde);
+    Q_EMIT dragLeave(event);
     setContainsDrag(false);
 }
 
@@ -74,6 +89,22 @@ void DeclarativeDropArea::dragMoveEvent(QDragMoveEvent *event)
         event->ignore();
         return;
     }
+
+    // the bounding rect may be larger than the shape of the containment mask:
+    // moving out of the shape leaves the area, moving back in enters it again
+    if (!isInsideMask(event->position())) {
+        if (m_containsDrag) {
+            DeclarativeDragDropEvent dde(event, this);
+            leave(&dde);
+        }
+        event->ignore();
+        return;
+    }
+    if (!m_containsDrag && containmentMask()) {
+        enter(event);
+        return;
+    }
+
     event->accept();
     // if the position we export didn't change, don't generate the move event
     if (event->position() == m_oldDragMovePos) {
@@ -94,7 +125,7 @@ void DeclarativeDropArea::dropEvent(QDropEvent *event)
 
     m_oldDragMovePos = QPoint(-1, -1);
 
-    if (!m_enabled || m_temporaryInhibition) {
+    if (!m_enabled || m_temporaryInhibition || !isInsideMask(event->position())) {
         return;
     }
 
@@ -103,6 +134,12 @@ void DeclarativeDropArea::dropEvent(QDropEvent *event)
     setContainsDrag(false);
 }
 
+bool DeclarativeDropArea::isInsideMask(const QPointF &point) const
+{
+    // without a mask the whole bounding rect accepts drops, as Qt only delivers events inside it
+    return !containmentMask() || contains(point);
+}
+
 bool DeclarativeDropArea::isEnabled() const
 {
     return m_enabled;
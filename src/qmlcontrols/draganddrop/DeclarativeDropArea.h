@@ -83,6 +83,9 @@ private Q_SLOTS:
     void temporaryInhibitParent(bool inhibit);
 
 private:
+    void enter(QDragMoveEvent *event);
+    void leave(DeclarativeDragDropEvent *event);
+    bool isInsideMask(const QPointF &point) const;
     void setContainsDrag(bool dragging);
 
     bool m_enabled : 1;
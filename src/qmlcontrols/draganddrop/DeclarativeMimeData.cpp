@@ -36,19 +36,45 @@ DeclarativeMimeData::DeclarativeMimeData(const QMimeData *copy)
     : QMimeData()
     , m_source(nullptr)
 {
+    const DeclarativeMimeData *declarativeMimeData = qobject_cast<const DeclarativeMimeData *>(copy);
+
     // Copy the standard MIME data
     const auto formats = copy->formats();
     for (const QString &format : formats) {
+        // Don't serialize the payloads, they are copied as they are below
+        if (declarativeMimeData) {
+            if (const Payload *payload = declarativeMimeData->payload(format)) {
+                m_payloads.insert(format, *payload);
+                continue;
+            }
+        }
         QMimeData::setData(format, copy->data(format));
     }
 
     // If the object we are copying actually is a DeclarativeMimeData, copy our extended properties as well
-    const DeclarativeMimeData *declarativeMimeData = qobject_cast<const DeclarativeMimeData *>(copy);
     if (declarativeMimeData) {
         this->setSource(declarativeMimeData->source());
     }
 }
 
+void DeclarativeMimeData::setText(const QString &text)
+{
+    if (this->text() != text) {
+        m_payloads.remove(QStringLiteral("text/plain"));
+        QMimeData::setText(text);
+        Q_EMIT textChanged();
+    }
+}
+
+void DeclarativeMimeData::setHtml(const QString &html)
+{
+    if (this->html() != html) {
+        m_payloads.remove(QStringLiteral("text/html"));
+        QMimeData::setHtml(html);
+        Q_EMIT htmlChanged();
+    }
+}
+
 /*!
     \qmlproperty url MimeData::url
 
@@ -70,6 +96,7 @@ void DeclarativeMimeData::setUrl(const QUrl &url)
 
     QList<QUrl> urlList;
     urlList.append(url);
+    m_payloads.remove(QStringLiteral("text/uri-list"));
     QMimeData::setUrls(urlList);
     Q_EMIT urlChanged();
 }
@@ -91,6 +118,7 @@ void DeclarativeMimeData::setUrls(const QJsonArray &urls)
     for (const auto &varUrl : urls) {
         urlList << QUrl(varUrl.toString());
     }
+    m_payloads.remove(QStringLiteral("text/uri-list"));
     QMimeData::setUrls(urlList);
     Q_EMIT urlsChanged();
 }
@@ -113,6 +141,7 @@ bool DeclarativeMimeData::hasColor() const
 void DeclarativeMimeData::setColor(const QColor &color)
 {
     if (this->color() != color) {
+        m_payloads.remove(QStringLiteral("application/x-color"));
         this->setColorData(color);
         Q_EMIT colorChanged();
     }
@@ -121,10 +150,84 @@ void DeclarativeMimeData::setColor(const QColor &color)
 void DeclarativeMimeData::setData(const QString &mimeType, const QVariant &data)
 {
     if (data.userType() == QMetaType::QByteArray) {
+        m_payloads.remove(mimeType);
         QMimeData::setData(mimeType, data.toByteArray());
-    } else if (data.canConvert<QString>()) {
-        QMimeData::setData(mimeType, data.toString().toLatin1());
+        return;
+    }
+
+    // Kept as is, for the drop areas of this application the drag never goes through bytes
+    QMimeData::removeFormat(mimeType);
+    Payload payload{data, nullptr};
+    if (data.metaType().flags() & QMetaType::PointerToQObject) {
+        payload.object = data.value<QObject *>();
+    }
+    m_payloads.insert(mimeType, payload);
+}
+
+QVariant DeclarativeMimeData::getData(const QString &mimeType) const
+{
+    if (const Payload *payload = this->payload(mimeType)) {
+        return payloadValue(*payload);
+    }
+    return QMimeData::data(mimeType);
+}
+
+const DeclarativeMimeData::Payload *DeclarativeMimeData::payload(const QString &mimeType) const
+{
+    const auto it = m_payloads.constFind(mimeType);
+    if (it == m_payloads.constEnd()) {
+        return nullptr;
+    }
+    // Setting a payload removes the bytes of the format, bytes written afterwards through
+    // QMimeData, e.g. by C++ code holding a QMimeData pointer, replace it
+    if (QMimeData::formats().contains(mimeType)) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+QVariant DeclarativeMimeData::payloadValue(const Payload &payload) const
+{
+    if (payload.value.metaType().flags() & QMetaType::PointerToQObject) {
+        return QVariant::fromValue(payload.object.data());
+    }
+    return payload.value;
+}
+
+QStringList DeclarativeMimeData::formats() const
+{
+    const QStringList byteFormats = QMimeData::formats();
+    QStringList formats = byteFormats;
+    for (auto it = m_payloads.constBegin(); it != m_payloads.constEnd(); ++it) {
+        // Replaced by bytes written through QMimeData
+        if (!byteFormats.contains(it.key())) {
+            formats.append(it.key());
+        }
+    }
+    return formats;
+}
+
+QVariant DeclarativeMimeData::retrieveData(const QString &mimeType, QMetaType type) const
+{
+    const Payload *payload = this->payload(mimeType);
+    if (!payload) {
+        return QMimeData::retrieveData(mimeType, type);
+    }
+
+    const QVariant value = payloadValue(*payload);
+    if (type.id() != QMetaType::QByteArray) {
+        // text(), urls() and colorData() convert what they get themselves
+        return value;
+    }
+
+    // Another application or data() asked for the bytes: only now serialize
+    if (value.metaType().flags() & QMetaType::PointerToQObject) {
+        return QVariant();
+    }
+    if (value.canConvert<QString>()) {
+        return value.toString().toLatin1();
     }
+    return QVariant();
 }
 
 /*!
@@ -9,8 +9,10 @@
 #define DECLARATIVEMIMEDATA_H
 
 #include <QColor>
+#include <QHash>
 #include <QJsonArray>
 #include <QMimeData>
+#include <QPointer>
 #include <QQuickItem>
 #include <QUrl>
 
@@ -61,6 +63,10 @@ public:
     DeclarativeMimeData();
     DeclarativeMimeData(const QMimeData *copy);
 
+    // Drop a payload of the format, the setters of QMimeData can't be overridden
+    void setText(const QString &text);
+    void setHtml(const QString &html);
+
     QUrl url() const;
     void setUrl(const QUrl &url);
 
@@ -71,30 +77,53 @@ public:
     void setColor(const QColor &color);
     Q_INVOKABLE bool hasColor() const;
 
+    /**
+     * Sets the data of @p mimeType.
+     *
+     * Byte arrays are stored as they are. Any other value, including objects, is kept
+     * unchanged for the drop areas of this application, which read it back with getData().
+     * It is only serialized, as a Latin-1 string, when another application asks for
+     * the format; objects are never serialized.
+     */
     Q_INVOKABLE void setData(const QString &mimeType, const QVariant &data);
 
+    /**
+     * The data of @p mimeType as it was given to setData(), without going through
+     * its serialization, or the bytes of the format when it wasn't set from this application.
+     * @since 6.0
+     */
+    Q_INVOKABLE QVariant getData(const QString &mimeType) const;
+
+    QStringList formats() const override;
+
     QQuickItem *source() const;
     void setSource(QQuickItem *source);
 
     Q_INVOKABLE QByteArray getDataAsByteArray(const QString &format);
 
-    /*
-    QString text() const;                //TODO: Reimplement this to issue the onChanged signals
-    void setText(const QString &text);
-    QString html() const;
-    void setHtml(const QString &html);
-    */
-
 Q_SIGNALS:
-    void textChanged(); // FIXME not being used
-    void htmlChanged(); // FIXME not being used
+    void textChanged();
+    void htmlChanged();
     void urlChanged();
     void urlsChanged();
     void colorChanged();
     void sourceChanged();
 
+protected:
+    QVariant retrieveData(const QString &mimeType, QMetaType type) const override;
+
 private:
+    struct Payload {
+        QVariant value;
+        // Guards the payloads which are objects, they may be destroyed during the drag
+        QPointer<QObject> object;
+    };
+
+    const Payload *payload(const QString &mimeType) const;
+    QVariant payloadValue(const Payload &payload) const;
+
     QQuickItem *m_source;
+    QHash<QString, Payload> m_payloads;
 };
 
 #endif // DECLARATIVEMIMEDATA_H
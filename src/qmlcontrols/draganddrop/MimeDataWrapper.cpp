@@ -5,6 +5,7 @@
 */
 
 #include "MimeDataWrapper.h"
+#include "DeclarativeMimeData.h"
 #include <QMimeData>
 #include <QUrl>
 
@@ -66,6 +67,14 @@ QByteArray MimeDataWrapper::getDataAsByteArray(const QString &format)
     return m_data->data(format);
 }
 
+QVariant MimeDataWrapper::getData(const QString &format) const
+{
+    if (auto declarativeMimeData = qobject_cast<const DeclarativeMimeData *>(m_data)) {
+        return declarativeMimeData->getData(format);
+    }
+    return m_data->data(format);
+}
+
 QVariant MimeDataWrapper::source() const
 {
     //     In case it comes from a DeclarativeMimeData
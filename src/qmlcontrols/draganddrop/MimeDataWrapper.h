@@ -85,6 +85,13 @@ public:
 
     Q_INVOKABLE QByteArray getDataAsByteArray(const QString &format);
 
+    /**
+     * The data of @p format, unserialized when it was set with DeclarativeMimeData::setData()
+     * in this application.
+     * @since 6.0
+     */
+    Q_INVOKABLE QVariant getData(const QString &format) const;
+
 private:
     const QMimeData *m_data;
 };
@@ -16,8 +16,12 @@ import QtQuick
  * lobes. Everything is done in the shader, with some defaults set for
  * parameters. These defaults were designed to provide a good visual result when
  * scaling down window thumbnails.
+ *
+ * For large downscale ratios, see the pyramid property.
  */
 ShaderEffect {
+    id: root
+
     /**
      * The source texture. Can be any QQuickTextureProvider.
      */
@@ -61,6 +65,57 @@ ShaderEffect {
      */
     property real resolution: 0.98;
 
-    vertexShader: Qt.resolvedUrl(":/shaders/preserveaspect.vert.qsb")
-    fragmentShader: Qt.resolvedUrl(":/shaders/lanczos2sharp.frag.qsb")
+    /**
+     * Whether to prefilter the source for large downscale ratios.
+     *
+     * The kernel only looks at a 4x4 neighbourhood, so when shrinking a lot most of
+     * the source is skipped and the result aliases. In pyramid mode the source is
+     * rendered with mipmaps, cheap 2x box downsamples of each other, and the kernel
+     * samples the level that brings the remaining ratio within its support. The cost
+     * per pixel is then the same whatever the ratio, plus rendering the mipmaps.
+     *
+     * The source must be an Item. Defaults to false.
+     */
+    property bool pyramid: false
+
+    /**
+     * The mip level sampled in pyramid mode, the largest one with at least one texel per target pixel:
+     * floor(log2(ratio)) for a downscale ratio above 1, which leaves a remaining ratio between 1 and 2.
+     */
+    readonly property real lod: {
+        if (!pyramid || targetSize.width <= 0 || targetSize.height <= 0) {
+            return 0;
+        }
+        const ratio = Math.max(sourceSize.width / targetSize.width, sourceSize.height / targetSize.height);
+        return Math.max(0, Math.floor(Math.log2(ratio)));
+    }
+
+    readonly property var pyramidSource: pyramid ? pyramidTexture : null
+
+    ShaderEffectSource {
+        id: pyramidTexture
+        visible: false
+        sourceItem: root.pyramid ? root.source : null
+        textureSize: root.sourceSize
+        mipmap: true
+    }
+
+    // Sources in the texture atlas of the scene graph are sampled in place rather than
+    // copied out first. The mipmapped copy of pyramid mode is never in an atlas.
+    supportsAtlasTextures: !pyramid
+
+    vertexShader: pyramid ? Qt.resolvedUrl(":/shaders/preserveaspect_pyramid.vert.qsb") : Qt.resolvedUrl(":/shaders/preserveaspect.vert.qsb")
+    // Variants with the parameters compiled in are used when possible, see CMakeLists.txt
+    fragmentShader: {
+        let variant = "lanczos2sharp";
+        if (antiRingingStrength === 0) {
+            variant += "_noantiringing";
+        } else if (windowSinc === 0.4 && sinc === 1.0 && antiRingingStrength === 0.65 && resolution === 0.98) {
+            variant += "_defaults";
+        }
+        if (pyramid) {
+            variant += "_pyramid";
+        }
+        return Qt.resolvedUrl(":/shaders/" + variant + ".frag.qsb");
+    }
 }
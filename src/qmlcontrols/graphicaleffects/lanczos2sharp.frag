@@ -33,22 +33,61 @@ layout(location = 0) out vec4 fragColor;
 layout(std140, binding = 0) uniform buf {
     mat4 qt_Matrix;
     float qt_Opacity;
+#ifndef PYRAMID
+    // Where the source is in its texture, which may be an atlas
+    vec4 qt_SubRect_source;
+#endif
 
     vec2 targetSize;
     float windowSinc;
     float sinc;
     float antiRingingStrength;
     float resolution;
+#ifdef PYRAMID
+    float lod;
+#endif
 } ubuf;
 
+#ifdef PYRAMID
+// The source with its mipmaps: each level is a 2x box downsample of the previous one.
+// Sampling the level whose texels are about as large as the target pixels keeps the
+// remaining ratio within the support of the kernel, whatever the scale.
+layout(binding = 1) uniform sampler2D pyramidSource;
+#define SAMPLE(coord) textureLod(pyramidSource, coord, ubuf.lod)
+#else
 layout(binding = 1) uniform sampler2D source;
+#define SAMPLE(coord) texture(source, atlasCoord(coord))
+
+// Maps coord, from 0 to 1 over the source, into its subrect of the texture. The neighbour
+// fetches around the edges are clamped half a texel inside it, so that they never blend
+// in the images next to the source in an atlas.
+vec2 atlasCoord(vec2 coord)
+{
+    vec2 inset = 0.5 / vec2(textureSize(source, 0));
+    vec2 coordInTexture = ubuf.qt_SubRect_source.xy + coord * ubuf.qt_SubRect_source.zw;
+    return clamp(coordInTexture, ubuf.qt_SubRect_source.xy + inset, ubuf.qt_SubRect_source.xy + ubuf.qt_SubRect_source.zw - inset);
+}
+#endif
 
 // A=0.5, B=0.825 is the best jinc approximation for x<2.5. if B=1.0, it's a lanczos filter.
 // Increase A to get more blur. Decrease it to get a sharper picture.
 // B = 0.825 to get rid of dithering. Increase B to get a fine sharpness, though dithering returns.
 
-#define wa (ubuf.windowSinc * pi)
-#define wb (ubuf.sinc * pi)
+#ifdef DEFAULT_PARAMETERS
+// The defaults of Lanczos.qml, letting the compiler fold them
+#define WINDOW_SINC 0.4
+#define SINC 1.0
+#define ANTI_RINGING_STRENGTH 0.65
+#define RESOLUTION 0.98
+#else
+#define WINDOW_SINC ubuf.windowSinc
+#define SINC ubuf.sinc
+#define ANTI_RINGING_STRENGTH ubuf.antiRingingStrength
+#define RESOLUTION ubuf.resolution
+#endif
+
+#define wa (WINDOW_SINC * pi)
+#define wb (SINC * pi)
 
 const float pi = 3.1415926535897932384626433832795;
 const vec3 dtt = vec3(65536.0, 255.0, 1.0);
@@ -84,8 +123,8 @@ void main()
     vec2 dx = vec2(1.0, 0.0);
     vec2 dy = vec2(0.0, 1.0);
 
-    vec2 pixelCoord = texcoord * ubuf.targetSize / ubuf.resolution;
-    vec2 texel = (floor(pixelCoord) + vec2(0.5, 0.5)) * ubuf.resolution / ubuf.targetSize;
+    vec2 pixelCoord = texcoord * ubuf.targetSize / RESOLUTION;
+    vec2 texel = (floor(pixelCoord) + vec2(0.5, 0.5)) * RESOLUTION / ubuf.targetSize;
 
     vec2 texelCenter = (floor(pixelCoord - vec2(0.5, 0.5)) + vec2(0.5, 0.5));
 
@@ -107,46 +146,48 @@ void main()
                               distance(pixelCoord, texelCenter + dx + 2.0 * dy),
                               distance(pixelCoord, texelCenter + 2.0 * dx + 2.0 * dy)));
 
-    dx = dx * ubuf.resolution / ubuf.targetSize;
-    dy = dy * ubuf.resolution / ubuf.targetSize;
-    texelCenter = texelCenter * ubuf.resolution / ubuf.targetSize;
+    dx = dx * RESOLUTION / ubuf.targetSize;
+    dy = dy * RESOLUTION / ubuf.targetSize;
+    texelCenter = texelCenter * RESOLUTION / ubuf.targetSize;
 
     // reading the texels
-    vec3 color = texture(source, texcoord).xyz;
-
-    vec3 c00 = texture(source, texelCenter - dx - dy).xyz;
-    vec3 c10 = texture(source, texelCenter - dy).xyz;
-    vec3 c20 = texture(source, texelCenter + dx - dy).xyz;
-    vec3 c30 = texture(source, texelCenter + 2.0 * dx - dy).xyz;
-    vec3 c01 = texture(source, texelCenter - dx).xyz;
-    vec3 c11 = texture(source, texelCenter).xyz;
-    vec3 c21 = texture(source, texelCenter + dx).xyz;
-    vec3 c31 = texture(source, texelCenter + 2.0 * dx).xyz;
-    vec3 c02 = texture(source, texelCenter - dx + dy).xyz;
-    vec3 c12 = texture(source, texelCenter + dy).xyz;
-    vec3 c22 = texture(source, texelCenter + dx + dy).xyz;
-    vec3 c32 = texture(source, texelCenter + 2.0 * dx + dy).xyz;
-    vec3 c03 = texture(source, texelCenter - dx + 2.0 * dy).xyz;
-    vec3 c13 = texture(source, texelCenter + 2.0 * dy).xyz;
-    vec3 c23 = texture(source, texelCenter + dx + 2.0 * dy).xyz;
-    vec3 c33 = texture(source, texelCenter + 2.0 * dx + 2.0 * dy).xyz;
-
-    vec3 F6 = texture(source, texel + dx + 0.25 * dx + 0.25 * dy).xyz;
-    vec3 F7 = texture(source, texel + dx + 0.25 * dx - 0.25 * dy).xyz;
-    vec3 F8 = texture(source, texel + dx - 0.25 * dx - 0.25 * dy).xyz;
-    vec3 F9 = texture(source, texel + dx - 0.25 * dx + 0.25 * dy).xyz;
-
-    vec3 H6 = texture(source, texel + 0.25 * dx + 0.25 * dy + dy).xyz;
-    vec3 H7 = texture(source, texel + 0.25 * dx - 0.25 * dy + dy).xyz;
-    vec3 H8 = texture(source, texel - 0.25 * dx - 0.25 * dy + dy).xyz;
-    vec3 H9 = texture(source, texel - 0.25 * dx + 0.25 * dy + dy).xyz;
+    vec3 color = SAMPLE(texcoord).xyz;
+
+    vec3 c00 = SAMPLE(texelCenter - dx - dy).xyz;
+    vec3 c10 = SAMPLE(texelCenter - dy).xyz;
+    vec3 c20 = SAMPLE(texelCenter + dx - dy).xyz;
+    vec3 c30 = SAMPLE(texelCenter + 2.0 * dx - dy).xyz;
+    vec3 c01 = SAMPLE(texelCenter - dx).xyz;
+    vec3 c11 = SAMPLE(texelCenter).xyz;
+    vec3 c21 = SAMPLE(texelCenter + dx).xyz;
+    vec3 c31 = SAMPLE(texelCenter + 2.0 * dx).xyz;
+    vec3 c02 = SAMPLE(texelCenter - dx + dy).xyz;
+    vec3 c12 = SAMPLE(texelCenter + dy).xyz;
+    vec3 c22 = SAMPLE(texelCenter + dx + dy).xyz;
+    vec3 c32 = SAMPLE(texelCenter + 2.0 * dx + dy).xyz;
+    vec3 c03 = SAMPLE(texelCenter - dx + 2.0 * dy).xyz;
+    vec3 c13 = SAMPLE(texelCenter + 2.0 * dy).xyz;
+    vec3 c23 = SAMPLE(texelCenter + dx + 2.0 * dy).xyz;
+    vec3 c33 = SAMPLE(texelCenter + 2.0 * dx + 2.0 * dy).xyz;
+
+    vec3 F6 = SAMPLE(texel + dx + 0.25 * dx + 0.25 * dy).xyz;
+    vec3 F7 = SAMPLE(texel + dx + 0.25 * dx - 0.25 * dy).xyz;
+    vec3 F8 = SAMPLE(texel + dx - 0.25 * dx - 0.25 * dy).xyz;
+    vec3 F9 = SAMPLE(texel + dx - 0.25 * dx + 0.25 * dy).xyz;
+
+    vec3 H6 = SAMPLE(texel + 0.25 * dx + 0.25 * dy + dy).xyz;
+    vec3 H7 = SAMPLE(texel + 0.25 * dx - 0.25 * dy + dy).xyz;
+    vec3 H8 = SAMPLE(texel - 0.25 * dx - 0.25 * dy + dy).xyz;
+    vec3 H9 = SAMPLE(texel - 0.25 * dx + 0.25 * dy + dy).xyz;
 
     vec4 f0 = reduce4(F6, F7, F8, F9);
     vec4 h0 = reduce4(H6, H7, H8, H9);
 
+#ifndef NO_ANTIRINGING
     //  Get min/max samples
     vec3 min_sample = min4(c11, c21, c12, c22);
     vec3 max_sample = max4(c11, c21, c12, c22);
+#endif
 
     color = weights[0] * transpose(mat4x3(c00, c10, c20, c30));
     color += weights[1] * transpose(mat4x3(c01, c11, c21, c31));
@@ -154,12 +195,14 @@ void main()
     color += weights[3] * transpose(mat4x3(c03, c13, c23, c33));
     color = color / dot(vec4(1.0) * weights, vec4(1.0));
 
+#ifndef NO_ANTIRINGING
     // Anti-ringing
     vec3 aux = color;
     color = clamp(color, min_sample, max_sample);
 
-    color = mix(aux, color, ubuf.antiRingingStrength);
+    color = mix(aux, color, ANTI_RINGING_STRENGTH);
+#endif
 
-    float alpha = texture(source, texcoord).a * ubuf.qt_Opacity;
+    float alpha = SAMPLE(texcoord).a * ubuf.qt_Opacity;
     fragColor = vec4(color, alpha);
 }
@@ -19,6 +19,10 @@ layout(location = 0) out vec2 coord;
 layout(std140, binding = 0) uniform buf {
     mat4 qt_Matrix;
     float qt_Opacity;
+#ifndef PYRAMID
+    // Where the source is in its texture, which may be an atlas
+    vec4 qt_SubRect_source;
+#endif
 
     vec2 sourceSize;
     vec2 targetSize;
@@ -31,6 +35,14 @@ void main() {
     vec2 newOffset = (ubuf.targetSize - newSize) / 2.0;
     vec2 uvOffset = (1.0 / newSize) * newOffset;
 
-    coord = -uvOffset + (ubuf.targetSize / newSize) * texcoord;
+#ifdef PYRAMID
+    // The mipmapped copy of the source is never in an atlas
+    vec2 uv = texcoord;
+#else
+    // With an atlas texture, texcoord spans the subrect of the source rather than 0 to 1
+    vec2 uv = (texcoord - ubuf.qt_SubRect_source.xy) / ubuf.qt_SubRect_source.zw;
+#endif
+
+    coord = -uvOffset + (ubuf.targetSize / newSize) * uv;
     gl_Position = ubuf.qt_Matrix * position;
 }
@@ -67,11 +67,6 @@ RowLayout {
         }
     }
 
-    KQuickControlsPrivate.TranslationContext {
-        id: _tr
-        domain: "kdeclarative6"
-    }
-
     Button {
         id: mainButton
 
@@ -87,8 +82,8 @@ RowLayout {
             const keys = helper.isRecording ? helper.currentKeySequence : root.keySequence
             const text = helper.keySequenceIsEmpty(keys)
                 ? (helper.isRecording
-                    ? _tr.i18nc("What the user inputs now will be taken as the new shortcut", "Input")
-                    : _tr.i18nc("No shortcut defined", "None"))
+                    ? KQuickControlsPrivate.KeySequenceStrings.input
+                    : KQuickControlsPrivate.KeySequenceStrings.none)
                 // Single ampersand gets interpreted by the button as a mnemonic
                 // and removed; replace it with a double ampersand so that it
                 // will be displayed by the button as a single ampersand, or
@@ -99,12 +94,11 @@ RowLayout {
             return " " + text + (helper.isRecording ? " ... " : " ")
         }
 
-        Accessible.description: _tr.i18n("Click on the button, then enter the shortcut like you would in the program.\nExample for Ctrl+A: hold the Ctrl key and press A.")
+        Accessible.description: KQuickControlsPrivate.KeySequenceStrings.description
 
-        ToolTip {
-            visible: mainButton.hovered
-            text: mainButton.Accessible.description
-        }
+        // The attached ToolTip is shared by all items, rather than one per button
+        ToolTip.visible: hovered
+        ToolTip.text: Accessible.description
 
         onCheckedChanged: {
             if (checked) {
@@ -135,39 +129,34 @@ RowLayout {
             root.captureFinished(); // Not really capturing, but otherwise we cannot track this state, hence apps should use keySequenceModified
         }
 
-        // Just a helper object
-        Text {
-            id: theText
-            visible: false
-            text: root.keySequence
-        }
-        enabled: theText.text.length > 0
+        enabled: !helper.keySequenceIsEmpty(root.keySequence)
 
         hoverEnabled: true
         // icon name determines the direction of the arrow, NOT the direction of the app layout
         icon.name: Qt.application.layoutDirection === Qt.LeftToRight ? "edit-clear-locationbar-rtl" : "edit-clear-locationbar-ltr"
 
-        Accessible.name: _tr.i18nc("@info:tooltip", "Clear Key Sequence")
+        Accessible.name: KQuickControlsPrivate.KeySequenceStrings.clear
 
-        ToolTip {
-            visible: clearButton.hovered
-            text: clearButton.Accessible.name
-        }
+        ToolTip.visible: hovered
+        ToolTip.text: Accessible.name
     }
 
-    Button {
+    // Only exists while recording, most instances never need it
+    Loader {
         Layout.fillHeight: true
         Layout.preferredWidth: height
-        onClicked: helper.cancelRecording()
-        visible: root.showCancelButton && helper.isRecording
+        active: root.showCancelButton && helper.isRecording
+        visible: active
+
+        sourceComponent: Button {
+            onClicked: helper.cancelRecording()
 
-        icon.name: "dialog-cancel"
+            icon.name: "dialog-cancel"
 
-        Accessible.name: _tr.i18nc("@info:tooltip", "Cancel Key Sequence Recording")
+            Accessible.name: KQuickControlsPrivate.KeySequenceStrings.cancel
 
-        ToolTip {
-            visible: parent.hovered
-            text: parent.Accessible.name
+            ToolTip.visible: hovered
+            ToolTip.text: Accessible.name
         }
     }
 }
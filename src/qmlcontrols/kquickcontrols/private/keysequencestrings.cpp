@@ -0,0 +1,56 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "keysequencestrings.h"
+
+#include <KLocalizedString>
+
+KeySequenceStrings::KeySequenceStrings(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QString KeySequenceStrings::input() const
+{
+    if (m_input.isNull()) {
+        m_input = i18nc("What the user inputs now will be taken as the new shortcut", "Input");
+    }
+    return m_input;
+}
+
+QString KeySequenceStrings::none() const
+{
+    if (m_none.isNull()) {
+        m_none = i18nc("No shortcut defined", "None");
+    }
+    return m_none;
+}
+
+QString KeySequenceStrings::description() const
+{
+    if (m_description.isNull()) {
+        m_description = i18n("Click on the button, then enter the shortcut like you would in the program.\nExample for Ctrl+A: hold the Ctrl key and press A.");
+    }
+    return m_description;
+}
+
+QString KeySequenceStrings::clear() const
+{
+    if (m_clear.isNull()) {
+        m_clear = i18nc("@info:tooltip", "Clear Key Sequence");
+    }
+    return m_clear;
+}
+
+QString KeySequenceStrings::cancel() const
+{
+    if (m_cancel.isNull()) {
+        m_cancel = i18nc("@info:tooltip", "Cancel Key Sequence Recording");
+    }
+    return m_cancel;
+}
+
+#include "moc_keysequencestrings.cpp"
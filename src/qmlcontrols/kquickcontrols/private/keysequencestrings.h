@@ -0,0 +1,46 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#ifndef KEYSEQUENCESTRINGS_H
+#define KEYSEQUENCESTRINGS_H
+
+#include <QObject>
+
+/**
+ * The user visible strings of KeySequenceItem, translated once per engine
+ * and shared by all of its instances instead of each one looking them up.
+ *
+ * Each string is only translated when it is first read, so creating the
+ * singleton doesn't wait for the catalog, which is still being loaded on a
+ * worker thread, and the strings only shown on demand cost nothing until then.
+ */
+class KeySequenceStrings : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString input READ input CONSTANT)
+    Q_PROPERTY(QString none READ none CONSTANT)
+    Q_PROPERTY(QString description READ description CONSTANT)
+    Q_PROPERTY(QString clear READ clear CONSTANT)
+    Q_PROPERTY(QString cancel READ cancel CONSTANT)
+
+public:
+    explicit KeySequenceStrings(QObject *parent = nullptr);
+
+    QString input() const;
+    QString none() const;
+    QString description() const;
+    QString clear() const;
+    QString cancel() const;
+
+private:
+    mutable QString m_input;
+    mutable QString m_none;
+    mutable QString m_description;
+    mutable QString m_clear;
+    mutable QString m_cancel;
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include <QQmlEngine>
 
 #include "keysequencehelper.h"
+#include "keysequencestrings.h"
 #include "translationcontext.h"
 
 void KQuickControlsPrivatePlugin::registerTypes(const char *uri)
@@ -16,9 +17,15 @@ void KQuickControlsPrivatePlugin::registerTypes(const char *uri)
     Q_ASSERT(QString::fromLatin1(uri) == QLatin1String("org.kde.private.kquickcontrols"));
     qmlRegisterType<KeySequenceHelper>(uri, 2, 0, "KeySequenceHelper");
     qmlRegisterType<TranslationContext>(uri, 2, 0, "TranslationContext");
+    qmlRegisterSingletonType<KeySequenceStrings>(uri, 2, 0, "KeySequenceStrings", [](QQmlEngine *, QJSEngine *) -> QObject * {
+        return new KeySequenceStrings;
+    });
     // Register the Helper again publicly but uncreatable, so one can access the shortcuttype enum
     // values as for example "ShortcutType.StandardShortcuts" from qml
     qmlRegisterUncreatableType<KeySequenceHelper>("org.kde.kquickcontrols", 2, 0, "ShortcutType", QStringLiteral("This is just to allow accessing the enum"));
+
+    // Needed as soon as the first KeySequenceItem is created
+    TranslationContext::warmUp(QStringLiteral(TRANSLATION_DOMAIN));
 }
 
 #include "moc_kquickcontrolsprivateplugin.cpp"
@@ -10,9 +10,18 @@
 #include "translationcontext.h"
 
 #include <QDebug>
+#include <QMutex>
+#include <QSet>
+#include <QThreadPool>
 
 #include <KLocalizedString>
 
+namespace
+{
+QMutex s_warmedUpMutex;
+QSet<QString> s_warmedUpDomains;
+}
+
 TranslationContext::TranslationContext(QObject *parent)
     : QObject(parent)
 {
@@ -34,9 +43,30 @@ void TranslationContext::setDomain(const QString &domain)
     }
 
     m_domain = domain;
+    warmUp(m_domain);
     Q_EMIT domainChanged(domain);
 }
 
+void TranslationContext::warmUp(const QString &domain)
+{
+    if (domain.isEmpty()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&s_warmedUpMutex);
+        if (s_warmedUpDomains.contains(domain)) {
+            return;
+        }
+        s_warmedUpDomains.insert(domain);
+    }
+
+    QThreadPool::globalInstance()->start([utf8Domain = domain.toUtf8()]() {
+        // Any lookup loads the catalog, KLocalizedString serializes them itself
+        ki18nd(utf8Domain.constData(), "warm-up").toString();
+    });
+}
+
 QString TranslationContext::i18n(const QString &message,
                                  const QString &param1,
                                  const QString &param2,
@@ -266,4 +296,29 @@ QString TranslationContext::i18ncp(const QString &context,
     return trMessage.toString();
 }
 
+QStringList TranslationContext::i18ncBatch(const QVariantList &messages) const
+{
+    // Encoded once for all of the messages
+    const QByteArray domain = m_domain.toUtf8();
+
+    QStringList translations;
+    translations.reserve(messages.size());
+    for (const QVariant &entry : messages) {
+        const QVariantList tuple = entry.toList();
+        if (tuple.size() < 2) {
+            qWarning() << "i18ncBatch() needs a context and a message in each entry";
+            translations.append(QString());
+            continue;
+        }
+
+        KLocalizedString trMessage = ki18ndc(domain.constData(), tuple.at(0).toString().toUtf8().constData(), tuple.at(1).toString().toUtf8().constData());
+        for (int i = 2; i < tuple.size(); ++i) {
+            trMessage = trMessage.subs(tuple.at(i).toString());
+        }
+        translations.append(trMessage.toString());
+    }
+
+    return translations;
+}
+
 #include "moc_translationcontext.cpp"
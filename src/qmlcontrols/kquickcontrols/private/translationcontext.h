@@ -8,6 +8,7 @@
 #define TRANSLATIONCONTEXT_H
 
 #include <QObject>
+#include <QVariant>
 
 class TranslationContext : public QObject
 {
@@ -79,6 +80,28 @@ public:
                                const QString &param9 = QString(),
                                const QString &param10 = QString()) const;
 
+    /**
+     * Translates many messages with context in one call, as i18nc() would one by one.
+     *
+     * Each entry of @p messages is an array of the context, the message and then the
+     * arguments of the message, for example
+     * @code
+     * tr.i18ncBatch([["@label", "Name"], ["@label", "%1 items", count]])
+     * @endcode
+     *
+     * @return the translations, in the order of @p messages. Invalid entries
+     * give an empty string.
+     * @since 6.0
+     */
+    Q_INVOKABLE QStringList i18ncBatch(const QVariantList &messages) const;
+
+    /**
+     * Loads the catalog of @p domain for the current languages on a worker thread,
+     * so that the first translation on the gui thread doesn't have to.
+     * Each domain is only loaded once per process.
+     */
+    static void warmUp(const QString &domain);
+
 private:
     Q_DISABLE_COPY(TranslationContext)
 
@@ -0,0 +1,111 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "adaptivequality.h"
+#include "imagedecodescheduler.h"
+
+#include <QTimer>
+
+AdaptiveQuality::AdaptiveQuality(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool AdaptiveQuality::isEnabled() const
+{
+    return m_enabled;
+}
+
+void AdaptiveQuality::setEnabled(bool enabled)
+{
+    if (enabled == m_enabled) {
+        return;
+    }
+
+    m_enabled = enabled;
+    if (!m_enabled) {
+        m_resizing = false;
+        delete m_settleTimer;
+        m_settleTimer = nullptr;
+        clear();
+    }
+}
+
+bool AdaptiveQuality::isResizing() const
+{
+    return m_resizing;
+}
+
+void AdaptiveQuality::sizeChanged(const QSizeF &newSize, const QSizeF &oldSize)
+{
+    // The first layout is not a resize, it would get painted twice
+    if (!m_enabled || !m_framePainted || oldSize.isEmpty() || newSize == oldSize) {
+        return;
+    }
+
+    if (!m_settleTimer) {
+        m_settleTimer = new QTimer(this);
+        m_settleTimer->setSingleShot(true);
+        m_settleTimer->setInterval(150);
+        connect(m_settleTimer, &QTimer::timeout, this, [this]() {
+            m_resizing = false;
+            Q_EMIT settled();
+            Q_EMIT changed();
+        });
+    }
+    m_resizing = true;
+    m_settleTimer->start();
+}
+
+void AdaptiveQuality::setFramePainted(bool painted)
+{
+    m_framePainted = painted;
+}
+
+void AdaptiveQuality::prescale(const QImage &image, qint64 key, const QSize &targetSize)
+{
+    // Bilinear filtering only looks at the four closest pixels, which aliases when shrinking by more than half
+    const bool shrunk = !targetSize.isEmpty() && (targetSize.width() * 2 < image.width() || targetSize.height() * 2 < image.height());
+    if (!m_enabled || m_resizing || image.isNull() || !shrunk) {
+        clear();
+        return;
+    }
+
+    if ((m_prescaledKey == key && m_prescaled.size() == targetSize) || (m_pendingKey == key && m_pendingSize == targetSize)) {
+        return;
+    }
+
+    // Scaling a large image takes several frames worth of time, keep it off the gui thread
+    m_pendingKey = key;
+    m_pendingSize = targetSize;
+    const quint64 generation = ++m_generation;
+    ImageDecodeScheduler::instance()->scale(image, targetSize, this, [this, key, generation](const QImage &scaled) {
+        if (generation != m_generation) {
+            return;
+        }
+        m_pendingKey = 0;
+        m_pendingSize = QSize();
+        m_prescaled = scaled;
+        m_prescaledKey = key;
+        Q_EMIT changed();
+    });
+}
+
+QImage AdaptiveQuality::prescaled(qint64 key) const
+{
+    return m_prescaledKey == key ? m_prescaled : QImage();
+}
+
+void AdaptiveQuality::clear()
+{
+    ++m_generation;
+    m_pendingKey = 0;
+    m_pendingSize = QSize();
+    m_prescaled = QImage();
+    m_prescaledKey = 0;
+}
+
+#include "moc_adaptivequality.cpp"
@@ -0,0 +1,87 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef ADAPTIVEQUALITY_H
+#define ADAPTIVEQUALITY_H
+
+#include <QImage>
+#include <QObject>
+
+class QTimer;
+
+/**
+ * The adaptiveQuality mode of QImageItem and QPixmapItem.
+ *
+ * While the item is being resized, isResizing() tells it to draw with fast sampling.
+ * Once the size didn't change for a short while, settled() is emitted and the item
+ * draws with its smooth path again, from a copy scaled down with area averaging on a
+ * worker thread when it is shrunk by more than half, which is both sharper and cheaper
+ * to draw than filtering the full image every time.
+ *
+ * Only the first layout isn't a resize: size changes before setFramePainted() are ignored.
+ */
+class AdaptiveQuality : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AdaptiveQuality(QObject *parent = nullptr);
+
+    bool isEnabled() const;
+    void setEnabled(bool enabled);
+
+    bool isResizing() const;
+
+    /**
+     * To be called by the item whenever its size changes
+     */
+    void sizeChanged(const QSizeF &newSize, const QSizeF &oldSize);
+
+    /**
+     * To be called once the item drew its image, @p painted tells whether it was at a valid size
+     */
+    void setFramePainted(bool painted);
+
+    /**
+     * Asks for the copy of @p image, whose cache key is @p key, scaled to @p targetSize
+     *
+     * Nothing is scaled while disabled or resizing, nor if @p image isn't shrunk by more
+     * than half. changed() is emitted once the copy is ready.
+     */
+    void prescale(const QImage &image, qint64 key, const QSize &targetSize);
+
+    /**
+     * The scaled copy of the image with cache key @p key, null if there is none (yet)
+     */
+    QImage prescaled(qint64 key) const;
+
+Q_SIGNALS:
+    /**
+     * The item stopped being resized and should ask for a scaled copy again
+     */
+    void settled();
+
+    /**
+     * A scaled copy is ready, or isResizing() changed, the item should repaint
+     */
+    void changed();
+
+private:
+    void clear();
+
+    bool m_enabled = false;
+    bool m_resizing = false;
+    bool m_framePainted = false;
+    QTimer *m_settleTimer = nullptr;
+    QImage m_prescaled;
+    qint64 m_prescaledKey = 0;
+    // What is being scaled, results of older requests are dropped
+    qint64 m_pendingKey = 0;
+    QSize m_pendingSize;
+    quint64 m_generation = 0;
+};
+
+#endif
@@ -0,0 +1,127 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "blurhash.h"
+
+#include <QList>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr QLatin1String Base83Characters("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz#$%*+,-.:;=?@[]^_{|}~");
+
+// Returns -1 for characters outside of the alphabet
+int decode83(QStringView string)
+{
+    int value = 0;
+    for (const QChar c : string) {
+        const int digit = Base83Characters.indexOf(c);
+        if (digit < 0) {
+            return -1;
+        }
+        value = value * 83 + digit;
+    }
+    return value;
+}
+
+float sRgbToLinear(int value)
+{
+    const float v = value / 255.0f;
+    return v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+}
+
+int linearToSRgb(float value)
+{
+    const float v = std::clamp(value, 0.0f, 1.0f);
+    return v <= 0.0031308f ? int(v * 12.92f * 255 + 0.5f) : int((1.055f * std::pow(v, 1 / 2.4f) - 0.055f) * 255 + 0.5f);
+}
+
+float signPow(float value, float exponent)
+{
+    return std::copysign(std::pow(std::abs(value), exponent), value);
+}
+
+struct Color {
+    float r;
+    float g;
+    float b;
+};
+}
+
+namespace BlurHash
+{
+QImage decode(const QString &hash, const QSize &size, qreal punch)
+{
+    if (hash.size() < 6 || size.isEmpty()) {
+        return QImage();
+    }
+
+    const int sizeFlag = decode83(QStringView(hash).first(1));
+    const int numX = sizeFlag % 9 + 1;
+    const int numY = sizeFlag / 9 + 1;
+    if (sizeFlag < 0 || hash.size() != 4 + 2 * numX * numY) {
+        return QImage();
+    }
+
+    const int quantisedMaximum = decode83(QStringView(hash).sliced(1, 1));
+    const float maximum = (quantisedMaximum + 1) / 166.0f * punch;
+
+    QList<Color> colors(numX * numY);
+
+    const int dc = decode83(QStringView(hash).sliced(2, 4));
+    if (quantisedMaximum < 0 || dc < 0) {
+        return QImage();
+    }
+    colors[0] = {sRgbToLinear(dc >> 16), sRgbToLinear((dc >> 8) & 255), sRgbToLinear(dc & 255)};
+
+    for (int i = 1; i < colors.size(); ++i) {
+        const int ac = decode83(QStringView(hash).sliced(4 + i * 2, 2));
+        if (ac < 0) {
+            return QImage();
+        }
+        colors[i] = {signPow((ac / (19 * 19) - 9) / 9.0f, 2) * maximum,
+                     signPow((ac / 19 % 19 - 9) / 9.0f, 2) * maximum,
+                     signPow((ac % 19 - 9) / 9.0f, 2) * maximum};
+    }
+
+    // The basis functions only depend on one coordinate each, compute them once
+    QList<float> cosX(size.width() * numX);
+    for (int x = 0; x < size.width(); ++x) {
+        for (int i = 0; i < numX; ++i) {
+            cosX[x * numX + i] = std::cos(float(M_PI) * x * i / size.width());
+        }
+    }
+    QList<float> cosY(size.height() * numY);
+    for (int y = 0; y < size.height(); ++y) {
+        for (int j = 0; j < numY; ++j) {
+            cosY[y * numY + j] = std::cos(float(M_PI) * y * j / size.height());
+        }
+    }
+
+    QImage image(size, QImage::Format_RGB32);
+    for (int y = 0; y < size.height(); ++y) {
+        auto *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < size.width(); ++x) {
+            Color pixel{0, 0, 0};
+            for (int j = 0; j < numY; ++j) {
+                for (int i = 0; i < numX; ++i) {
+                    const float basis = cosX[x * numX + i] * cosY[y * numY + j];
+                    const Color &color = colors[i + j * numX];
+                    pixel.r += color.r * basis;
+                    pixel.g += color.g * basis;
+                    pixel.b += color.b * basis;
+                }
+            }
+            line[x] = qRgb(linearToSRgb(pixel.r), linearToSRgb(pixel.g), linearToSRgb(pixel.b));
+        }
+    }
+
+    return image;
+}
+}
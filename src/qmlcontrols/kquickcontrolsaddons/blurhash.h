@@ -0,0 +1,27 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef BLURHASH_H
+#define BLURHASH_H
+
+#include <QImage>
+#include <QString>
+
+namespace BlurHash
+{
+/**
+ * Decodes the BlurHash @p hash, see https://blurha.sh, to an image of @p size.
+ *
+ * A BlurHash encodes a handful of cosine components of an image in 20 to 30
+ * characters; a small @p size is enough, the result is meant to be upscaled.
+ *
+ * @param punch Scales the contrast of the result, 1 for the encoded one
+ * @return A null image if @p hash is not valid
+ */
+QImage decode(const QString &hash, const QSize &size = QSize(32, 32), qreal punch = 1.0);
+}
+
+#endif
@@ -5,17 +5,17 @@
 */
 
 #include "clipboard.h"
+#include "clipboardbackend.h"
 #include <QDebug>
-#include <QGuiApplication>
 #include <QMimeData>
 #include <QUrl>
 
 Clipboard::Clipboard(QObject *parent)
     : QObject(parent)
-    , m_clipboard(QGuiApplication::clipboard())
+    , m_backend(ClipboardBackend::instance())
     , m_mode(QClipboard::Clipboard)
 {
-    connect(m_clipboard, &QClipboard::changed, this, &Clipboard::clipboardChanged);
+    connect(m_backend, &ClipboardBackend::changed, this, &Clipboard::clipboardChanged);
 }
 
 void Clipboard::setMode(QClipboard::Mode mode)
@@ -33,7 +33,7 @@ void Clipboard::clipboardChanged(QClipboard::Mode m)
 
 void Clipboard::clear()
 {
-    m_clipboard->clear(m_mode);
+    m_backend->clear(m_mode);
 }
 
 QClipboard::Mode Clipboard::mode() const
@@ -43,29 +43,13 @@ QClipboard::Mode Clipboard::mode() const
 
 QVariant Clipboard::contentFormat(const QString &format) const
 {
-    const QMimeData *data = m_clipboard->mimeData(m_mode);
-    QVariant ret;
-    if (format == QLatin1String("text/uri-list")) {
-        QVariantList retList;
-        const auto urls = data->urls();
-        for (const QUrl &url : urls) {
-            retList += url;
-        }
-        ret = retList;
-    } else if (format.startsWith(QLatin1String("text/"))) {
-        ret = data->text();
-    } else if (format.startsWith(QLatin1String("image/"))) {
-        ret = data->imageData();
-    } else {
-        ret = data->data(format.isEmpty() ? data->formats().first() : format);
-    }
-
-    return ret;
+    return m_backend->content(m_mode, format);
 }
 
 QVariant Clipboard::content() const
 {
-    return contentFormat(m_clipboard->mimeData(m_mode)->formats().first());
+    const QStringList formats = m_backend->formats(m_mode);
+    return formats.isEmpty() ? QVariant() : contentFormat(formats.constFirst());
 }
 
 void Clipboard::setContent(const QVariant &content)
@@ -108,12 +92,12 @@ void Clipboard::setContent(const QVariant &content)
         }
         break;
     }
-    m_clipboard->setMimeData(mimeData, m_mode);
+    m_backend->setMimeData(mimeData, m_mode);
 }
 
 QStringList Clipboard::formats() const
 {
-    return m_clipboard->mimeData(m_mode)->formats();
+    return m_backend->formats(m_mode);
 }
 
 #include "moc_clipboard.cpp"
@@ -11,7 +11,7 @@
 #include <QVariant>
 #include <qqmlregistration.h>
 
-class ClipboardPrivate;
+class ClipboardBackend;
 
 /**
  * @brief Wrapper for QClipboard
@@ -33,6 +33,9 @@ class ClipboardPrivate;
  *     }
  * }
  * ```
+ *
+ * All instances share a single listener on QClipboard and a cache of the decoded
+ * content of each mode, so having many of them is cheap.
  */
 class Clipboard : public QObject
 {
@@ -80,7 +83,7 @@ private Q_SLOTS:
     void clipboardChanged(QClipboard::Mode m);
 
 private:
-    QClipboard *m_clipboard;
+    ClipboardBackend *m_backend;
     QClipboard::Mode m_mode;
 };
 
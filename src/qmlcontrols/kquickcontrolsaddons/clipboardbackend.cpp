@@ -0,0 +1,92 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "clipboardbackend.h"
+
+#include <QGuiApplication>
+#include <QMimeData>
+#include <QUrl>
+
+ClipboardBackend *ClipboardBackend::instance()
+{
+    static ClipboardBackend *s_instance = new ClipboardBackend(QCoreApplication::instance());
+    return s_instance;
+}
+
+ClipboardBackend::ClipboardBackend(QObject *parent)
+    : QObject(parent)
+    , m_clipboard(QGuiApplication::clipboard())
+{
+    connect(m_clipboard, &QClipboard::changed, this, &ClipboardBackend::clipboardChanged);
+}
+
+void ClipboardBackend::clipboardChanged(QClipboard::Mode mode)
+{
+    m_caches.remove(mode);
+    Q_EMIT changed(mode);
+}
+
+QStringList ClipboardBackend::formats(QClipboard::Mode mode)
+{
+    Cache &cache = m_caches[mode];
+    if (!cache.formatsValid) {
+        const QMimeData *data = m_clipboard->mimeData(mode);
+        cache.formats = data ? data->formats() : QStringList();
+        cache.formatsValid = true;
+    }
+    return cache.formats;
+}
+
+QVariant ClipboardBackend::content(QClipboard::Mode mode, const QString &format)
+{
+    Cache &cache = m_caches[mode];
+    auto it = cache.contents.constFind(format);
+    if (it == cache.contents.constEnd()) {
+        it = cache.contents.insert(format, decode(mode, format));
+    }
+    return *it;
+}
+
+QVariant ClipboardBackend::decode(QClipboard::Mode mode, const QString &format) const
+{
+    const QMimeData *data = m_clipboard->mimeData(mode);
+    if (!data) {
+        return QVariant();
+    }
+
+    QVariant ret;
+    if (format == QLatin1String("text/uri-list")) {
+        QVariantList retList;
+        const auto urls = data->urls();
+        for (const QUrl &url : urls) {
+            retList += url;
+        }
+        ret = retList;
+    } else if (format.startsWith(QLatin1String("text/"))) {
+        ret = data->text();
+    } else if (format.startsWith(QLatin1String("image/"))) {
+        ret = data->imageData();
+    } else {
+        ret = data->data(format.isEmpty() ? data->formats().value(0) : format);
+    }
+
+    return ret;
+}
+
+void ClipboardBackend::setMimeData(QMimeData *mimeData, QClipboard::Mode mode)
+{
+    // Not every platform reports our own changes synchronously, don't serve the old content meanwhile
+    m_caches.remove(mode);
+    m_clipboard->setMimeData(mimeData, mode);
+}
+
+void ClipboardBackend::clear(QClipboard::Mode mode)
+{
+    m_caches.remove(mode);
+    m_clipboard->clear(mode);
+}
+
+#include "moc_clipboardbackend.cpp"
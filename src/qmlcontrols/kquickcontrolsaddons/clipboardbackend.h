@@ -0,0 +1,66 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef CLIPBOARDBACKEND_H
+#define CLIPBOARDBACKEND_H
+
+#include <QClipboard>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QVariant>
+
+class QMimeData;
+
+/**
+ * The process wide state behind all Clipboard instances.
+ *
+ * It listens to QClipboard once, and keeps the formats and the decoded content of each
+ * format of every mode until the next change of that mode, so that any number of
+ * Clipboard objects reading the same mode cost a single conversion per change.
+ */
+class ClipboardBackend : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ClipboardBackend *instance();
+
+    /**
+     * The content of @p format in @p mode, decoded as described in Clipboard::contentFormat()
+     */
+    QVariant content(QClipboard::Mode mode, const QString &format);
+    QStringList formats(QClipboard::Mode mode);
+
+    /**
+     * Replaces the content of @p mode, taking ownership of @p mimeData
+     */
+    void setMimeData(QMimeData *mimeData, QClipboard::Mode mode);
+    void clear(QClipboard::Mode mode);
+
+Q_SIGNALS:
+    /**
+     * Emitted once per change of @p mode, after its cache was dropped
+     */
+    void changed(QClipboard::Mode mode);
+
+private:
+    explicit ClipboardBackend(QObject *parent);
+
+    struct Cache {
+        bool formatsValid = false;
+        QStringList formats;
+        QHash<QString, QVariant> contents;
+    };
+
+    void clipboardChanged(QClipboard::Mode mode);
+    QVariant decode(QClipboard::Mode mode, const QString &format) const;
+
+    QClipboard *m_clipboard;
+    QHash<QClipboard::Mode, Cache> m_caches;
+};
+
+#endif
@@ -0,0 +1,276 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "imageanalysis.h"
+
+#include <QtEndian>
+
+#include <algorithm>
+#include <array>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+// Whether all pixels of a row of 32 bit pixels have all bits of alphaMask set
+bool isRowOpaque(const quint32 *pixels, int count, quint32 alphaMask)
+{
+    int i = 0;
+
+#ifdef __SSE2__
+    const __m128i mask = _mm_set1_epi32(int(alphaMask));
+    __m128i all = _mm_set1_epi32(-1);
+    for (; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i + 4));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i + 8));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i + 12));
+        all = _mm_and_si128(all, _mm_and_si128(_mm_and_si128(a, b), _mm_and_si128(c, d)));
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, mask), mask)) != 0xffff) {
+        return false;
+    }
+#endif
+
+    quint32 all32 = 0xffffffff;
+    for (; i < count; ++i) {
+        all32 &= pixels[i];
+    }
+    return (all32 & alphaMask) == alphaMask;
+}
+
+// Sums of the B, G, R and A bytes of premultiplied ARGB32 pixels
+std::array<quint64, 4> sumChannels(const quint32 *pixels, int count)
+{
+    std::array<quint64, 4> sums{0, 0, 0, 0};
+    int i = 0;
+
+#ifdef __SSE2__
+    // The 32 bit lanes can't overflow, there are at most 64x64 pixels of 255
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum = zero;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+        const __m128i pairs = _mm_add_epi16(_mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero));
+        sum = _mm_add_epi32(sum, _mm_unpacklo_epi16(pairs, zero));
+        sum = _mm_add_epi32(sum, _mm_unpackhi_epi16(pairs, zero));
+    }
+    alignas(16) quint32 lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), sum);
+    for (int channel = 0; channel < 4; ++channel) {
+        sums[channel] = lanes[channel];
+    }
+#endif
+
+    for (; i < count; ++i) {
+        sums[0] += qBlue(pixels[i]);
+        sums[1] += qGreen(pixels[i]);
+        sums[2] += qRed(pixels[i]);
+        sums[3] += qAlpha(pixels[i]);
+    }
+    return sums;
+}
+
+struct HistogramEntry {
+    quint8 r;
+    quint8 g;
+    quint8 b;
+    int count;
+};
+
+struct Box {
+    int begin;
+    int end;
+    int population;
+};
+
+// The channel with the widest range in the box, 0 for red, 1 for green, 2 for blue
+int widestChannel(const QList<HistogramEntry> &entries, const Box &box, int *range)
+{
+    int min[3] = {255, 255, 255};
+    int max[3] = {0, 0, 0};
+    for (int i = box.begin; i < box.end; ++i) {
+        const int values[3] = {entries[i].r, entries[i].g, entries[i].b};
+        for (int channel = 0; channel < 3; ++channel) {
+            min[channel] = std::min(min[channel], values[channel]);
+            max[channel] = std::max(max[channel], values[channel]);
+        }
+    }
+
+    int widest = 0;
+    for (int channel = 1; channel < 3; ++channel) {
+        if (max[channel] - min[channel] > max[widest] - min[widest]) {
+            widest = channel;
+        }
+    }
+    *range = max[widest] - min[widest];
+    return widest;
+}
+
+QList<QColor> medianCut(QList<HistogramEntry> &entries, int paletteSize)
+{
+    QList<Box> boxes;
+    int population = 0;
+    for (const HistogramEntry &entry : std::as_const(entries)) {
+        population += entry.count;
+    }
+    if (entries.isEmpty()) {
+        return {};
+    }
+    boxes.append({0, int(entries.size()), population});
+
+    while (boxes.size() < paletteSize) {
+        // Split the box where it matters most: many pixels spread over a wide range
+        int best = -1;
+        int bestChannel = 0;
+        qint64 bestScore = 0;
+        for (int i = 0; i < boxes.size(); ++i) {
+            if (boxes[i].end - boxes[i].begin < 2) {
+                continue;
+            }
+            int range;
+            const int channel = widestChannel(entries, boxes[i], &range);
+            const qint64 score = qint64(range) * boxes[i].population;
+            if (score > bestScore) {
+                best = i;
+                bestChannel = channel;
+                bestScore = score;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+
+        const Box box = boxes[best];
+        std::sort(entries.begin() + box.begin, entries.begin() + box.end, [bestChannel](const HistogramEntry &a, const HistogramEntry &b) {
+            return bestChannel == 0 ? a.r < b.r : bestChannel == 1 ? a.g < b.g : a.b < b.b;
+        });
+
+        // Split at the weighted median, keeping at least one entry on each side
+        int median = box.begin;
+        int count = 0;
+        while (median < box.end - 1 && count + entries[median].count <= box.population / 2) {
+            count += entries[median].count;
+            ++median;
+        }
+        median = std::max(median, box.begin + 1);
+
+        int lowerPopulation = 0;
+        for (int i = box.begin; i < median; ++i) {
+            lowerPopulation += entries[i].count;
+        }
+        boxes[best] = {box.begin, median, lowerPopulation};
+        boxes.append({median, box.end, box.population - lowerPopulation});
+    }
+
+    std::sort(boxes.begin(), boxes.end(), [](const Box &a, const Box &b) {
+        return a.population > b.population;
+    });
+
+    QList<QColor> palette;
+    palette.reserve(boxes.size());
+    for (const Box &box : std::as_const(boxes)) {
+        qint64 r = 0;
+        qint64 g = 0;
+        qint64 b = 0;
+        for (int i = box.begin; i < box.end; ++i) {
+            r += qint64(entries[i].r) * entries[i].count;
+            g += qint64(entries[i].g) * entries[i].count;
+            b += qint64(entries[i].b) * entries[i].count;
+        }
+        palette.append(QColor(int(r / box.population), int(g / box.population), int(b / box.population)));
+    }
+    return palette;
+}
+}
+
+namespace ImageAnalysis
+{
+bool isOpaque(const QImage &image)
+{
+    if (image.isNull()) {
+        return false;
+    }
+
+    if (!image.hasAlphaChannel()) {
+        return true;
+    }
+
+    quint32 alphaMask;
+    switch (image.format()) {
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+        // 0xAARRGGBB in native byte order
+        alphaMask = 0xff000000;
+        break;
+    case QImage::Format_RGBA8888:
+    case QImage::Format_RGBA8888_Premultiplied:
+        // R, G, B, A in memory order
+        alphaMask = qFromLittleEndian<quint32>(0xff000000);
+        break;
+    default:
+        return false;
+    }
+
+    for (int y = 0; y < image.height(); ++y) {
+        if (!isRowOpaque(reinterpret_cast<const quint32 *>(image.constScanLine(y)), image.width(), alphaMask)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Colors extractColors(const QImage &image, int paletteSize)
+{
+    Colors colors;
+    if (image.isNull()) {
+        return colors;
+    }
+
+    // Bounded cost, there is no need for more pixels to tell the main colors
+    QImage small = image.width() > 64 || image.height() > 64 ? image.scaled(64, 64, Qt::KeepAspectRatio, Qt::FastTransformation) : image;
+    small = std::move(small).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    std::array<quint64, 4> sums{0, 0, 0, 0};
+    QList<int> histogram(32 * 32 * 32, 0);
+
+    for (int y = 0; y < small.height(); ++y) {
+        const auto *line = reinterpret_cast<const quint32 *>(small.constScanLine(y));
+
+        const std::array<quint64, 4> lineSums = sumChannels(line, small.width());
+        for (int channel = 0; channel < 4; ++channel) {
+            sums[channel] += lineSums[channel];
+        }
+
+        for (int x = 0; x < small.width(); ++x) {
+            if (qAlpha(line[x]) < 128) {
+                continue;
+            }
+            const QRgb color = qUnpremultiply(line[x]);
+            ++histogram[(qRed(color) >> 3) << 10 | (qGreen(color) >> 3) << 5 | (qBlue(color) >> 3)];
+        }
+    }
+
+    // Premultiplied sums divided by the alpha sum give the alpha weighted average
+    if (sums[3] > 0) {
+        colors.average = QColor(int(sums[2] * 255 / sums[3]), int(sums[1] * 255 / sums[3]), int(sums[0] * 255 / sums[3]), int(sums[3] / (small.width() * small.height())));
+    }
+
+    QList<HistogramEntry> entries;
+    for (int i = 0; i < histogram.size(); ++i) {
+        if (histogram[i] > 0) {
+            // The center of the bucket
+            entries.append({quint8((i >> 10) << 3 | 4), quint8(((i >> 5) & 31) << 3 | 4), quint8((i & 31) << 3 | 4), histogram[i]});
+        }
+    }
+    colors.palette = medianCut(entries, paletteSize);
+
+    return colors;
+}
+}
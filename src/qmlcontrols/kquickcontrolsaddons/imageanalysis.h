@@ -0,0 +1,42 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef IMAGEANALYSIS_H
+#define IMAGEANALYSIS_H
+
+#include <QColor>
+#include <QImage>
+#include <QList>
+
+namespace ImageAnalysis
+{
+/**
+ * Whether every pixel of @p image is fully opaque.
+ *
+ * Images without an alpha channel are opaque without looking at them. The 32 bit
+ * formats with alpha are scanned with SSE2 where available; for the other formats
+ * with alpha this conservatively returns false.
+ */
+bool isOpaque(const QImage &image);
+
+struct Colors {
+    // Alpha weighted average of all pixels
+    QColor average;
+    // The most common colors, most common first
+    QList<QColor> palette;
+};
+
+/**
+ * Extracts the average color and a palette of up to @p paletteSize colors from @p image.
+ *
+ * The image is first reduced to at most 64x64 pixels, so the cost doesn't depend on
+ * its size. The palette is computed with median cut on a 15 bit color histogram of the
+ * pixels which are at least half opaque. Can be called from any thread.
+ */
+Colors extractColors(const QImage &image, int paletteSize);
+}
+
+#endif
@@ -0,0 +1,203 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "imagedecodescheduler.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QImageReader>
+#include <QThreadPool>
+
+#include <algorithm>
+
+struct ImageDecodeJob {
+    struct Requester {
+        quint64 ticket;
+        QPointer<QObject> receiver;
+        ImageDecodeScheduler::Callback callback;
+    };
+
+    // Only touched on the gui thread
+    QList<Requester> requesters;
+    // Read by the decoding thread
+    QAtomicInt cancelled;
+};
+
+size_t qHash(const ImageDecodeScheduler::Key &key, size_t seed)
+{
+    return qHashMulti(seed, key.source, key.size.width(), key.size.height(), key.dpr, int(key.mode));
+}
+
+ImageDecodeScheduler *ImageDecodeScheduler::instance()
+{
+    static ImageDecodeScheduler *s_instance = new ImageDecodeScheduler(QCoreApplication::instance());
+    return s_instance;
+}
+
+ImageDecodeScheduler::ImageDecodeScheduler(QObject *parent)
+    : QObject(parent)
+{
+}
+
+quint64 ImageDecodeScheduler::request(const QUrl &source, const QSize &size, qreal dpr, TransformationMode mode, QObject *receiver, const Callback &callback)
+{
+    // All the ways of asking for the natural size, or for a dimension to follow the aspect ratio, share a decode
+    const QSize scaledSize = isScaledSize(size) ? QSize(std::max(size.width(), 0), std::max(size.height(), 0)) : QSize();
+    const Key key{source, scaledSize, dpr, mode};
+    const quint64 ticket = m_nextTicket++;
+    m_tickets.insert(ticket, key);
+
+    std::shared_ptr<ImageDecodeJob> &job = m_jobs[key];
+    if (job) {
+        // Somebody asked for the very same image already, piggyback on their decode
+        job->requesters.append({ticket, receiver, callback});
+        return ticket;
+    }
+
+    job = std::make_shared<ImageDecodeJob>();
+    job->requesters.append({ticket, receiver, callback});
+
+    QThreadPool::globalInstance()->start([this, key, job]() {
+        if (job->cancelled.loadAcquire()) {
+            return;
+        }
+        QImageIOHandler::Transformations transformation = QImageIOHandler::TransformationNone;
+        const QImage image = decode(key, *job, &transformation);
+        QMetaObject::invokeMethod(
+            this,
+            [this, job, image, transformation]() {
+                finish(job, image, transformation);
+            },
+            Qt::QueuedConnection);
+    });
+
+    return ticket;
+}
+
+void ImageDecodeScheduler::cancel(quint64 ticket)
+{
+    const auto keyIt = m_tickets.constFind(ticket);
+    if (keyIt == m_tickets.constEnd()) {
+        return;
+    }
+
+    const auto jobIt = m_jobs.constFind(*keyIt);
+    m_tickets.erase(keyIt);
+    if (jobIt == m_jobs.constEnd()) {
+        return;
+    }
+
+    const std::shared_ptr<ImageDecodeJob> job = *jobIt;
+    job->requesters.removeIf([ticket](const ImageDecodeJob::Requester &requester) {
+        return requester.ticket == ticket;
+    });
+
+    if (job->requesters.isEmpty()) {
+        job->cancelled.storeRelease(1);
+        m_jobs.erase(jobIt);
+    }
+}
+
+void ImageDecodeScheduler::scale(const QImage &image, const QSize &size, QObject *receiver, const std::function<void(const QImage &image)> &callback)
+{
+    QThreadPool::globalInstance()->start([this, image, size, receiver = QPointer<QObject>(receiver), callback]() {
+        const QImage scaled = image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        QMetaObject::invokeMethod(
+            this,
+            [receiver, scaled, callback]() {
+                if (receiver) {
+                    callback(scaled);
+                }
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+QImage ImageDecodeScheduler::decode(const Key &key, const ImageDecodeJob &job, QImageIOHandler::Transformations *transformation)
+{
+    QString fileName;
+    if (key.source.isLocalFile()) {
+        fileName = key.source.toLocalFile();
+    } else if (key.source.scheme() == QLatin1String("qrc")) {
+        fileName = QLatin1Char(':') + key.source.path();
+    } else if (key.source.isRelative()) {
+        fileName = key.source.path();
+    } else {
+        qWarning() << "Only local files and resources can be loaded:" << key.source;
+        return QImage();
+    }
+
+    QImageReader reader(fileName);
+    reader.setAutoTransform(key.mode == ApplyTransformation);
+    const QImageIOHandler::Transformations orientation = key.mode == IgnoreTransformation ? QImageIOHandler::TransformationNone : reader.transformation();
+
+    if (isScaledSize(key.size)) {
+        // Decoding at the target size is much cheaper for formats supporting it, e.g. JPEG.
+        // The scaled size applies before rotating, the requested one to the image as shown.
+        QSize targetSize = key.size * key.dpr;
+        if (orientation & QImageIOHandler::TransformationRotate90) {
+            targetSize.transpose();
+        }
+        const QSize imageSize = reader.size();
+        if (!imageSize.isEmpty()) {
+            // A dimension of 0 doesn't constrain the size, the other one determines the scale
+            qreal factor = 1;
+            if (targetSize.width() > 0) {
+                factor = std::min(factor, targetSize.width() / qreal(imageSize.width()));
+            }
+            if (targetSize.height() > 0) {
+                factor = std::min(factor, targetSize.height() / qreal(imageSize.height()));
+            }
+            if (factor < 1) {
+                reader.setScaledSize(QSize(std::max(1, qRound(imageSize.width() * factor)), std::max(1, qRound(imageSize.height() * factor))));
+            }
+        }
+    }
+
+    if (job.cancelled.loadAcquire()) {
+        return QImage();
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "Could not load" << key.source << reader.errorString();
+        return image;
+    }
+
+    if (key.mode == ReportTransformation) {
+        *transformation = orientation;
+    }
+
+    image.setDevicePixelRatio(key.dpr);
+    return image;
+}
+
+void ImageDecodeScheduler::finish(const std::shared_ptr<ImageDecodeJob> &job, const QImage &image, QImageIOHandler::Transformations transformation)
+{
+    if (job->cancelled.loadRelaxed()) {
+        return;
+    }
+
+    // A job is dropped once its last requester cancelled, so there is at least one, and the
+    // tickets of all of them map to the key of the job
+    const auto jobIt = m_jobs.constFind(m_tickets.value(job->requesters.constFirst().ticket));
+    if (jobIt != m_jobs.constEnd() && *jobIt == job) {
+        m_jobs.erase(jobIt);
+    }
+
+    for (const ImageDecodeJob::Requester &requester : std::as_const(job->requesters)) {
+        m_tickets.remove(requester.ticket);
+    }
+
+    const QList<ImageDecodeJob::Requester> requesters = job->requesters;
+    for (const ImageDecodeJob::Requester &requester : requesters) {
+        if (requester.receiver) {
+            requester.callback(image, transformation);
+        }
+    }
+}
+
+#include "moc_imagedecodescheduler.cpp"
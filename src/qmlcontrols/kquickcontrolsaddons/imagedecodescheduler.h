@@ -0,0 +1,116 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef IMAGEDECODESCHEDULER_H
+#define IMAGEDECODESCHEDULER_H
+
+#include <QHash>
+#include <QImage>
+#include <QImageIOHandler>
+#include <QObject>
+#include <QPointer>
+#include <QSize>
+#include <QUrl>
+
+#include <functional>
+#include <memory>
+
+struct ImageDecodeJob;
+
+/**
+ * Decodes image files for the image items on a thread pool.
+ *
+ * Requests are keyed by source, requested size and device pixel ratio. Concurrent
+ * requests with the same key share a single decode, whose result is delivered to
+ * every requester on the gui thread. A decode which didn't start yet is dropped
+ * once all of its requesters cancelled.
+ *
+ * Only local files and Qt resources are supported.
+ *
+ * The same threads also scale images down for the adaptive quality of the image items.
+ */
+class ImageDecodeScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Callback = std::function<void(const QImage &image, QImageIOHandler::Transformations transformation)>;
+
+    /**
+     * What to do with the orientation stored in the image metadata, e.g. the Exif orientation of photos
+     */
+    enum TransformationMode {
+        IgnoreTransformation, // the image is decoded as stored
+        ReportTransformation, // the image is decoded as stored, the orientation is passed to the callback to be applied when drawing
+        ApplyTransformation, // the orientation is applied to the pixels
+    };
+
+    static ImageDecodeScheduler *instance();
+
+    /**
+     * Whether @p size asks for the image to be scaled down, i.e. one of its dimensions is
+     * positive. A dimension of 0 or less is left to the aspect ratio, as with the
+     * sourceSize of Image.
+     */
+    static bool isScaledSize(const QSize &size)
+    {
+        return size.width() > 0 || size.height() > 0;
+    }
+
+    /**
+     * Decodes @p source scaled down to fit @p size in device independent pixels, or at its
+     * natural size if @p size isn't a scaled size, for a screen with device pixel ratio @p dpr.
+     *
+     * @p mode tells what to do with the orientation stored in the image metadata. Unless it is
+     * ReportTransformation, the transformation passed to @p callback is always TransformationNone.
+     * @p size applies to the image as shown, i.e. after the orientation if it isn't ignored.
+     *
+     * @p callback is invoked on the gui thread with the decoded image, or a null image if
+     * decoding failed, unless @p receiver was destroyed in the meantime.
+     *
+     * @return A ticket to pass to cancel(), never 0
+     */
+    quint64 request(const QUrl &source, const QSize &size, qreal dpr, TransformationMode mode, QObject *receiver, const Callback &callback);
+
+    /**
+     * Withdraws the request @p ticket, its callback won't be invoked
+     */
+    void cancel(quint64 ticket);
+
+    /**
+     * Scales @p image to @p size with area averaging on the threads decoding the images.
+     *
+     * @p callback is invoked on the gui thread with the scaled image, unless @p receiver
+     * was destroyed in the meantime. Unlike decodes, scales are neither shared nor cancelled,
+     * requesters drop the results they don't need anymore.
+     */
+    void scale(const QImage &image, const QSize &size, QObject *receiver, const std::function<void(const QImage &image)> &callback);
+
+private:
+    explicit ImageDecodeScheduler(QObject *parent = nullptr);
+
+    struct Key {
+        QUrl source;
+        QSize size;
+        qreal dpr;
+        TransformationMode mode;
+
+        bool operator==(const Key &other) const
+        {
+            return source == other.source && size == other.size && dpr == other.dpr && mode == other.mode;
+        }
+    };
+    friend size_t qHash(const Key &key, size_t seed);
+
+    static QImage decode(const Key &key, const ImageDecodeJob &job, QImageIOHandler::Transformations *transformation);
+    void finish(const std::shared_ptr<ImageDecodeJob> &job, const QImage &image, QImageIOHandler::Transformations transformation);
+
+    QHash<Key, std::shared_ptr<ImageDecodeJob>> m_jobs;
+    QHash<quint64, Key> m_tickets;
+    quint64 m_nextTicket = 1;
+};
+
+#endif
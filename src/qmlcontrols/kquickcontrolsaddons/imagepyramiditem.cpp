@@ -0,0 +1,402 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "imagepyramiditem.h"
+
+#include <QGuiApplication>
+#include <QHash>
+#include <QMatrix4x4>
+#include <QMutex>
+#include <QPointer>
+#include <QQuickWindow>
+#include <QSGImageNode>
+#include <QSGTexture>
+#include <QSGTransformNode>
+#include <QSet>
+#include <QThreadPool>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+quint64 tileKey(int level, int column, int row)
+{
+    return (quint64(level) << 48) | (quint64(quint32(column) & 0xffffff) << 24) | quint64(quint32(row) & 0xffffff);
+}
+
+QImage createTile(const QImage &levelImage, const QSize &imageSize, const QRect &tileRect, QRectF *sourceRect)
+{
+    // The tile in the pixels of its level, which are tileRect scaled down by about 1 << level
+    const qreal kx = levelImage.width() / qreal(imageSize.width());
+    const qreal ky = levelImage.height() / qreal(imageSize.height());
+    const QRectF levelRect(tileRect.x() * kx, tileRect.y() * ky, tileRect.width() * kx, tileRect.height() * ky);
+
+    // Include a one pixel gutter of the neighbouring tiles, so linear filtering doesn't show seams
+    const QRect outer = levelRect.toAlignedRect().adjusted(-1, -1, 1, 1) & levelImage.rect();
+    *sourceRect = levelRect.translated(-outer.topLeft());
+
+    return levelImage.copy(outer);
+}
+
+class ImagePyramidNode : public QSGTransformNode
+{
+public:
+    struct Tile {
+        QSGImageNode *node = nullptr;
+        qint64 bytes = 0;
+        quint64 lastUsed = 0;
+    };
+
+    ~ImagePyramidNode() override
+    {
+        // Tiles in the tree are deleted by QSGNode, the detached ones are ours
+        for (const Tile &tile : std::as_const(tiles)) {
+            if (!tile.node->parent()) {
+                delete tile.node;
+            }
+        }
+    }
+
+    void clear()
+    {
+        removeAllChildNodes();
+        for (const Tile &tile : std::as_const(tiles)) {
+            delete tile.node;
+        }
+        tiles.clear();
+        bytes = 0;
+    }
+
+    void evict(qint64 budget)
+    {
+        if (bytes <= budget) {
+            return;
+        }
+
+        QList<quint64> candidates;
+        for (auto it = tiles.constBegin(); it != tiles.constEnd(); ++it) {
+            if (!it->node->parent()) {
+                candidates.append(it.key());
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](quint64 a, quint64 b) {
+            return tiles.value(a).lastUsed < tiles.value(b).lastUsed;
+        });
+
+        for (const quint64 key : std::as_const(candidates)) {
+            if (bytes <= budget) {
+                break;
+            }
+            const Tile tile = tiles.take(key);
+            bytes -= tile.bytes;
+            delete tile.node;
+        }
+    }
+
+    QHash<quint64, Tile> tiles;
+    qint64 bytes = 0;
+    quint64 frame = 0;
+};
+}
+
+// The image at every level built so far, shared with the workers building tiles
+struct ImagePyramidItem::Levels {
+    explicit Levels(const QImage &image)
+        : images({image})
+    {
+    }
+
+    // Each level is halved from the one below, so a level costs a quarter of the
+    // previous one once instead of scaling TileSize << level pixels for every tile
+    QImage level(int level)
+    {
+        QMutexLocker locker(&mutex);
+        while (images.size() <= level) {
+            const QImage &previous = images.constLast();
+            // Scaling to exactly half the size averages boxes of 2x2 pixels
+            const QSize size(std::max(1, (previous.width() + 1) / 2), std::max(1, (previous.height() + 1) / 2));
+            images.append(previous.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+        }
+        return images.at(level);
+    }
+
+    QMutex mutex;
+    QList<QImage> images;
+};
+
+// Tiles requested by the render thread and built by the workers
+struct ImagePyramidItem::TileQueue {
+    struct Tile {
+        QImage image;
+        QRect rect;
+        QRectF sourceRect;
+    };
+
+    // Only dereferenced on the gui thread
+    QPointer<ImagePyramidItem> item;
+
+    QMutex mutex;
+    // Bumped when the image changes, tiles of older images are dropped
+    quint64 generation = 0;
+    QSet<quint64> pending;
+    QHash<quint64, Tile> ready;
+};
+
+ImagePyramidItem::ImagePyramidItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_tileQueue(std::make_shared<TileQueue>())
+{
+    m_tileQueue->item = this;
+    setFlag(ItemHasContents, true);
+    // Tiles at the edges may extend beyond the item, e.g. with PreserveAspectCrop
+    setClip(true);
+}
+
+ImagePyramidItem::~ImagePyramidItem()
+{
+}
+
+void ImagePyramidItem::setImage(const QImage &image, bool opaque)
+{
+    m_image = image;
+    m_levels = std::make_shared<Levels>(image);
+    m_imageOpaque = opaque;
+    m_imageChanged = true;
+    update();
+}
+
+void ImagePyramidItem::setImageTransform(const QTransform &transform)
+{
+    if (m_imageTransform == transform) {
+        return;
+    }
+
+    m_imageTransform = transform;
+    update();
+}
+
+void ImagePyramidItem::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == ItemSceneChange || change == ItemParentHasChanged) {
+        updateViewportConnections();
+    }
+
+    QQuickItem::itemChange(change, value);
+}
+
+void ImagePyramidItem::updateViewportConnections()
+{
+    for (const QMetaObject::Connection &connection : std::as_const(m_viewportConnections)) {
+        disconnect(connection);
+    }
+    m_viewportConnections.clear();
+
+    // Scrolling a Flickable moves its contentItem, so watch every ancestor
+    for (QQuickItem *ancestor = parentItem(); ancestor; ancestor = ancestor->parentItem()) {
+        m_viewportConnections << connect(ancestor, &QQuickItem::xChanged, this, &QQuickItem::update);
+        m_viewportConnections << connect(ancestor, &QQuickItem::yChanged, this, &QQuickItem::update);
+        m_viewportConnections << connect(ancestor, &QQuickItem::widthChanged, this, &QQuickItem::update);
+        m_viewportConnections << connect(ancestor, &QQuickItem::heightChanged, this, &QQuickItem::update);
+    }
+
+    if (QQuickWindow *w = window()) {
+        m_viewportConnections << connect(w, &QWindow::widthChanged, this, &QQuickItem::update);
+        m_viewportConnections << connect(w, &QWindow::heightChanged, this, &QQuickItem::update);
+    }
+}
+
+QRectF ImagePyramidItem::visibleRect() const
+{
+    QRectF rect = boundingRect();
+
+    for (QQuickItem *ancestor = parentItem(); ancestor; ancestor = ancestor->parentItem()) {
+        if (ancestor->clip()) {
+            rect &= mapRectFromItem(ancestor, ancestor->boundingRect());
+        }
+    }
+
+    if (QQuickWindow *w = window()) {
+        rect &= mapRectFromScene(QRectF(QPointF(0, 0), w->size()));
+    }
+
+    return rect;
+}
+
+void ImagePyramidItem::requestTile(quint64 key, int level, const QRect &tileRect)
+{
+    quint64 generation;
+    {
+        QMutexLocker locker(&m_tileQueue->mutex);
+        if (m_tileQueue->pending.contains(key)) {
+            return;
+        }
+        m_tileQueue->pending.insert(key);
+        generation = m_tileQueue->generation;
+    }
+
+    // Building a level the first time it is needed takes far too long for the sync
+    QThreadPool::globalInstance()->start([queue = m_tileQueue, levels = m_levels, imageSize = m_image.size(), key, level, tileRect, generation]() {
+        TileQueue::Tile tile;
+        tile.rect = tileRect;
+        tile.image = createTile(levels->level(level), imageSize, tileRect, &tile.sourceRect);
+
+        bool first;
+        {
+            QMutexLocker locker(&queue->mutex);
+            if (queue->generation != generation) {
+                return;
+            }
+            queue->pending.remove(key);
+            first = queue->ready.isEmpty();
+            queue->ready.insert(key, tile);
+        }
+
+        // One repaint picks up all the tiles finished until then
+        if (first) {
+            QMetaObject::invokeMethod(qApp, [queue]() {
+                if (queue->item) {
+                    queue->item->update();
+                }
+            });
+        }
+    });
+}
+
+QSGNode *ImagePyramidItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+
+    auto *node = static_cast<ImagePyramidNode *>(oldNode);
+
+    if (m_image.isNull() || !window()) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new ImagePyramidNode;
+    }
+
+    QHash<quint64, TileQueue::Tile> readyTiles;
+    {
+        QMutexLocker locker(&m_tileQueue->mutex);
+        if (m_imageChanged) {
+            ++m_tileQueue->generation;
+            m_tileQueue->pending.clear();
+            m_tileQueue->ready.clear();
+        }
+        readyTiles.swap(m_tileQueue->ready);
+    }
+
+    if (m_imageChanged) {
+        node->clear();
+        m_imageChanged = false;
+    }
+
+    // Only finished tiles are uploaded here
+    for (auto it = readyTiles.constBegin(); it != readyTiles.constEnd(); ++it) {
+        const TileQueue::Tile &ready = it.value();
+        // Requests are not repeated while pending, but don't replace a tile in use anyway
+        if (node->tiles.contains(it.key())) {
+            continue;
+        }
+
+        QSGImageNode *imageNode = window()->createImageNode();
+        imageNode->setTexture(window()->createTextureFromImage(ready.image, m_imageOpaque ? QQuickWindow::TextureIsOpaque : QQuickWindow::CreateTextureOptions()));
+        imageNode->setOwnsTexture(true);
+        imageNode->setSourceRect(ready.sourceRect);
+        imageNode->setRect(ready.rect);
+
+        ImagePyramidNode::Tile tile;
+        tile.node = imageNode;
+        tile.bytes = ready.image.sizeInBytes();
+        tile.lastUsed = node->frame;
+        node->tiles.insert(it.key(), tile);
+        node->bytes += tile.bytes;
+    }
+
+    node->setMatrix(QMatrix4x4(m_imageTransform));
+
+    const QRectF visibleImageRect = m_imageTransform.inverted().mapRect(visibleRect()) & QRectF(m_image.rect());
+
+    // Pick the level whose resolution is closest to, but not below, the one on screen
+    const qreal sx = std::hypot(m_imageTransform.m11(), m_imageTransform.m12());
+    const qreal sy = std::hypot(m_imageTransform.m21(), m_imageTransform.m22());
+    const qreal screenScale = std::max(sx, sy) * window()->effectiveDevicePixelRatio();
+    int level = 0;
+    while (screenScale * (2 << level) <= 1.0 && (std::max(m_image.width(), m_image.height()) >> (level + 1)) >= TileSize) {
+        ++level;
+    }
+
+    // Detach everything, the visible tiles are attached again below
+    node->removeAllChildNodes();
+    ++node->frame;
+
+    if (visibleImageRect.isEmpty()) {
+        node->evict(TextureBudget);
+        return node;
+    }
+
+    const int span = TileSize << level;
+    const int firstColumn = qFloor(visibleImageRect.left() / span);
+    const int lastColumn = qCeil(visibleImageRect.right() / span) - 1;
+    const int firstRow = qFloor(visibleImageRect.top() / span);
+    const int lastRow = qCeil(visibleImageRect.bottom() / span) - 1;
+
+    const QSGTexture::Filtering filtering = smooth() ? QSGTexture::Linear : QSGTexture::Nearest;
+
+    // Coarser tiles standing in for missing ones are drawn first, below the tiles of the current level
+    QList<QSGImageNode *> fallbacks;
+    QList<QSGImageNode *> current;
+    const auto use = [node, filtering](ImagePyramidNode::Tile &tile, QList<QSGImageNode *> &nodes) {
+        // A coarse tile may stand in for several missing ones, attach it once
+        if (tile.lastUsed == node->frame) {
+            return;
+        }
+        tile.lastUsed = node->frame;
+        tile.node->setFiltering(filtering);
+        nodes.append(tile.node);
+    };
+
+    const int imageExtent = std::max(m_image.width(), m_image.height());
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const quint64 key = tileKey(level, column, row);
+
+            auto it = node->tiles.find(key);
+            if (it != node->tiles.end()) {
+                use(*it, current);
+                continue;
+            }
+
+            requestTile(key, level, QRect(column * span, row * span, span, span) & m_image.rect());
+
+            for (int coarser = level + 1; (TileSize << coarser) <= imageExtent; ++coarser) {
+                const int shift = coarser - level;
+                auto fallback = node->tiles.find(tileKey(coarser, column >> shift, row >> shift));
+                if (fallback != node->tiles.end()) {
+                    use(*fallback, fallbacks);
+                    break;
+                }
+            }
+        }
+    }
+
+    for (QSGImageNode *tileNode : std::as_const(fallbacks)) {
+        node->appendChildNode(tileNode);
+    }
+    for (QSGImageNode *tileNode : std::as_const(current)) {
+        node->appendChildNode(tileNode);
+    }
+
+    node->evict(TextureBudget);
+
+    return node;
+}
+
+#include "moc_imagepyramiditem.cpp"
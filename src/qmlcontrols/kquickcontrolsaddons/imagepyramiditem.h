@@ -0,0 +1,80 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef IMAGEPYRAMIDITEM_H
+#define IMAGEPYRAMIDITEM_H
+
+#include <QImage>
+#include <QMetaObject>
+#include <QQuickItem>
+#include <QTransform>
+
+#include <memory>
+
+/**
+ * Renders a QImage as a pyramid of fixed size tiles.
+ *
+ * Used by QImageItem in tiled mode. Only the tiles intersecting the visible part of
+ * the item are created and uploaded, at the resolution matching the current scale;
+ * tiles that scroll out of view are kept around until TextureBudget is exceeded
+ * and then evicted, least recently used first. This bounds the memory of the
+ * textures and allows showing images bigger than the maximum texture size; the
+ * image itself and its downscaled levels, about a third more, stay in memory.
+ *
+ * Each level is scaled down from the previous one on a worker thread the first time
+ * one of its tiles is needed, tiles are cut from their level on worker threads and
+ * only uploaded once they are ready. A coarser tile already uploaded is shown in
+ * place of a missing one meanwhile.
+ *
+ * Visible means inside the window and inside every clipping ancestor, such as a
+ * Flickable, the item is repainted whenever one of its ancestors moves or resizes.
+ */
+class ImagePyramidItem : public QQuickItem
+{
+    Q_OBJECT
+
+public:
+    static constexpr int TileSize = 256;
+    // Upper bound for the memory used by the tile textures, in bytes
+    static constexpr qint64 TextureBudget = 64 * 1024 * 1024;
+
+    explicit ImagePyramidItem(QQuickItem *parent = nullptr);
+    ~ImagePyramidItem() override;
+
+    /**
+     * @p opaque tells whether all pixels of @p image are opaque, so tiles can be rendered without blending
+     */
+    void setImage(const QImage &image, bool opaque);
+
+    /**
+     * Maps image pixels to item coordinates, as determined by the fill mode
+     */
+    void setImageTransform(const QTransform &transform);
+
+    void updateViewportConnections();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+private:
+    struct Levels;
+    struct TileQueue;
+
+    QRectF visibleRect() const;
+    void requestTile(quint64 key, int level, const QRect &tileRect);
+
+    QImage m_image;
+    QTransform m_imageTransform;
+    std::shared_ptr<Levels> m_levels;
+    // Shared with the workers building tiles, which may outlive the item
+    std::shared_ptr<TileQueue> m_tileQueue;
+    bool m_imageOpaque = false;
+    bool m_imageChanged = false;
+    QList<QMetaObject::Connection> m_viewportConnections;
+};
+
+#endif
@@ -0,0 +1,107 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "imageuploadscheduler.h"
+
+#include <QQuickWindow>
+
+#include <algorithm>
+
+ImageUploadScheduler *ImageUploadScheduler::instance(QQuickWindow *window)
+{
+    auto *scheduler = window->findChild<ImageUploadScheduler *>(QString(), Qt::FindDirectChildrenOnly);
+    if (!scheduler) {
+        scheduler = new ImageUploadScheduler(window);
+    }
+    return scheduler;
+}
+
+ImageUploadScheduler::ImageUploadScheduler(QQuickWindow *window)
+    : QObject(window)
+    , m_window(window)
+{
+    // Emitted on the gui thread before the items are synchronized with the scene graph
+    connect(window, &QQuickWindow::afterAnimating, this, &ImageUploadScheduler::processFrame);
+}
+
+void ImageUploadScheduler::schedule(QQuickItem *item, const std::function<void()> &upload)
+{
+    m_pending.insert(item, Request{item, upload});
+    m_window->update();
+}
+
+void ImageUploadScheduler::cancel(QQuickItem *item)
+{
+    m_pending.remove(item);
+}
+
+qint64 ImageUploadScheduler::bytesPerFrame() const
+{
+    return m_bytesPerFrame;
+}
+
+void ImageUploadScheduler::setBytesPerFrame(qint64 bytes)
+{
+    m_bytesPerFrame = bytes;
+}
+
+void ImageUploadScheduler::processFrame()
+{
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    struct Candidate {
+        QQuickItem *key;
+        qreal visibleArea;
+        qint64 bytes;
+    };
+
+    const QRectF windowRect(QPointF(0, 0), m_window->size());
+    const qreal dpr = m_window->effectiveDevicePixelRatio();
+
+    QList<Candidate> candidates;
+    candidates.reserve(m_pending.size());
+
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        QQuickItem *item = it->item;
+        if (!item || item->window() != m_window) {
+            it = m_pending.erase(it);
+            continue;
+        }
+
+        const QRectF sceneRect = item->mapRectToScene(item->boundingRect());
+        const QRectF visibleRect = item->isVisible() ? sceneRect & windowRect : QRectF();
+        // Painted items upload a texture as big as the item
+        const qint64 bytes = qint64(sceneRect.width() * dpr) * qint64(sceneRect.height() * dpr) * 4;
+
+        candidates.append({it.key(), visibleRect.width() * visibleRect.height(), bytes});
+        ++it;
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.visibleArea > b.visibleArea;
+    });
+
+    qint64 spent = 0;
+    for (const Candidate &candidate : std::as_const(candidates)) {
+        if (spent > 0 && spent + candidate.bytes > m_bytesPerFrame) {
+            break;
+        }
+        spent += candidate.bytes;
+
+        const Request request = m_pending.take(candidate.key);
+        if (request.item) {
+            request.upload();
+        }
+    }
+
+    if (!m_pending.isEmpty()) {
+        m_window->update();
+    }
+}
+
+#include "moc_imageuploadscheduler.cpp"
@@ -0,0 +1,66 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef IMAGEUPLOADSCHEDULER_H
+#define IMAGEUPLOADSCHEDULER_H
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QQuickItem>
+
+#include <functional>
+
+class QQuickWindow;
+
+/**
+ * Spreads the texture uploads of image items over several frames.
+ *
+ * There is one scheduler per window. Items with a new image call schedule() instead
+ * of repainting right away; before every frame the scheduler grants the pending items
+ * with the largest visible area first, until the bytes of the textures they will
+ * upload exceed the per frame budget. At least one item is granted every frame, so
+ * items bigger than the budget still make progress.
+ *
+ * Until it is granted, an item is expected to keep showing its previous content.
+ */
+class ImageUploadScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qint64 DefaultBytesPerFrame = 8 * 1024 * 1024;
+
+    /**
+     * The scheduler of @p window, created on first use
+     */
+    static ImageUploadScheduler *instance(QQuickWindow *window);
+
+    /**
+     * Calls @p upload once @p item may repaint, replacing any pending request of @p item
+     */
+    void schedule(QQuickItem *item, const std::function<void()> &upload);
+    void cancel(QQuickItem *item);
+
+    qint64 bytesPerFrame() const;
+    void setBytesPerFrame(qint64 bytes);
+
+private:
+    explicit ImageUploadScheduler(QQuickWindow *window);
+
+    void processFrame();
+
+    struct Request {
+        QPointer<QQuickItem> item;
+        std::function<void()> upload;
+    };
+
+    QQuickWindow *const m_window;
+    QHash<QQuickItem *, Request> m_pending;
+    qint64 m_bytesPerFrame = DefaultBytesPerFrame;
+};
+
+#endif
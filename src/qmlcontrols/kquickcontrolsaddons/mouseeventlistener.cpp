@@ -6,6 +6,7 @@
 */
 
 #include "mouseeventlistener.h"
+#include "shapemask.h"
 
 #include <QDebug>
 #include <QEvent>
@@ -149,7 +150,8 @@ void MouseEventListener::mousePressEvent(QMouseEvent *me)
         viewPosition = window()->position();
     }
 
-    if (!QRectF(mapToScene(QPoint(0, 0)) + viewPosition, QSizeF(width(), height())).contains(me->globalPosition())) {
+    if (!QRectF(mapToScene(QPoint(0, 0)) + viewPosition, QSizeF(width(), height())).contains(me->globalPosition())
+        || !isInsideMask(me->position())) {
         me->ignore();
         return;
     }
@@ -236,7 +238,7 @@ void MouseEventListener::mouseReleaseEvent(QMouseEvent *me)
     Q_EMIT released(&dme);
     Q_EMIT pressedChanged();
 
-    if (boundingRect().contains(me->pos()) && m_pressAndHoldTimer->isActive()) {
+    if (boundingRect().contains(me->pos()) && isInsideMask(me->position()) && m_pressAndHoldTimer->isActive()) {
         Q_EMIT clicked(&dme);
         m_pressAndHoldTimer->stop();
     }
@@ -294,6 +296,11 @@ bool MouseEventListener::childMouseEventFilter(QQuickItem *item, QEvent *event)
         // the parent will receive events in its own coordinates
         const QPointF myPos = mapFromScene(me->scenePosition());
 
+        // children may be bigger than the shape of the listener
+        if (!isInsideMask(myPos)) {
+            break;
+        }
+
         KDeclarativeMouseEvent dme(myPos.x(),
                                    myPos.y(),
                                    me->globalPosition().x(),
@@ -335,6 +342,9 @@ bool MouseEventListener::childMouseEventFilter(QQuickItem *item, QEvent *event)
         m_lastEvent = event;
         QHoverEvent *he = static_cast<QHoverEvent *>(event);
         const QPointF myPos = item->mapToItem(this, he->position());
+        if (!isInsideMask(myPos)) {
+            break;
+        }
 
         QQuickWindow *w = window();
         QPoint screenPos;
@@ -466,6 +476,20 @@ bool MouseEventListener::childMouseEventFilter(QQuickItem *item, QEvent *event)
     //    return false;
 }
 
+bool MouseEventListener::isInsideMask(const QPointF &point) const
+{
+    QObject *mask = containmentMask();
+    if (!mask) {
+        // Without a mask children outside of the bounds are still listened to
+        return true;
+    }
+    // Avoids the dynamic invocation of contains() QQuickItem does for arbitrary masks
+    if (auto shapeMask = qobject_cast<ShapeMask *>(mask)) {
+        return shapeMask->contains(point);
+    }
+    return contains(point);
+}
+
 QScreen *MouseEventListener::screenForGlobalPos(const QPointF &globalPos)
 {
     const auto screens = QGuiApplication::screens();
@@ -298,6 +298,8 @@ private Q_SLOTS:
     void handleUngrab();
 
 private:
+    // Whether point, in coordinates of the listener, is inside its containmentMask if it has one
+    bool isInsideMask(const QPointF &point) const;
     static QScreen *screenForGlobalPos(const QPointF &globalPos);
 
     bool m_pressed;
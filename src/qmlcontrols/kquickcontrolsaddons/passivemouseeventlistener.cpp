@@ -0,0 +1,560 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passivemouseeventlistener.h"
+
+#include <QGuiApplication>
+#include <QMouseEvent>
+#include <QQuickWindow>
+#include <QScreen>
+#include <QStyleHints>
+#include <QTimer>
+#include <QTouchEvent>
+#include <QWheelEvent>
+
+#include <algorithm>
+
+/**
+ * The single event filter of a window, shared by all of its listeners.
+ *
+ * Presses, wheel events and hover moves go to the listeners under the position,
+ * outermost first; moves and releases of a press go to the listeners it pressed,
+ * wherever they are. Only the registered listeners are hit tested, the rest of the
+ * scene is only looked at around the listeners containing the position.
+ */
+class PassiveMouseEventRouter : public QObject
+{
+    Q_OBJECT
+
+public:
+    static PassiveMouseEventRouter *instance(QQuickWindow *window);
+
+    void add(PassiveMouseEventListener *listener);
+    void remove(PassiveMouseEventListener *listener);
+
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    using Listeners = QList<QPointer<PassiveMouseEventListener>>;
+
+    explicit PassiveMouseEventRouter(QQuickWindow *window);
+
+    Listeners listenersAt(const QPointF &scenePosition) const;
+    bool press(const QPointF &scenePosition, const QPointF &globalPosition, Qt::MouseButton button, Qt::MouseButtons buttons, Qt::KeyboardModifiers modifiers, Qt::MouseEventSource source);
+    bool move(const QPointF &scenePosition, const QPointF &globalPosition, Qt::MouseButtons buttons, Qt::KeyboardModifiers modifiers, Qt::MouseEventSource source);
+    bool release(const QPointF &scenePosition, const QPointF &globalPosition, Qt::MouseButton button, Qt::MouseButtons buttons, Qt::KeyboardModifiers modifiers, Qt::MouseEventSource source);
+
+    QQuickWindow *m_window;
+    QList<PassiveMouseEventListener *> m_listeners;
+};
+
+// Whether a press on item would be delivered to it. Listeners count, as MouseEventListener accepts presses.
+static bool takesPointerEvents(const QQuickItem *item)
+{
+    return item->acceptedMouseButtons() != Qt::NoButton || item->acceptTouchEvents() || qobject_cast<const PassiveMouseEventListener *>(item);
+}
+
+// The topmost item of the subtree of item under scenePosition taking pointer events
+static QQuickItem *itemAt(QQuickItem *item, const QPointF &scenePosition)
+{
+    if (!item->isVisible() || !item->isEnabled()) {
+        return nullptr;
+    }
+
+    const bool contained = item->contains(item->mapFromScene(scenePosition));
+    if (item->clip() && !contained) {
+        return nullptr;
+    }
+
+    // Children are stacked by z, then in order, and the ones with a negative z are below their parent
+    QList<QQuickItem *> children = item->childItems();
+    std::stable_sort(children.begin(), children.end(), [](const QQuickItem *a, const QQuickItem *b) {
+        return a->z() < b->z();
+    });
+    bool itemChecked = false;
+    for (auto it = children.crbegin(); it != children.crend(); ++it) {
+        if ((*it)->z() < 0 && !itemChecked) {
+            itemChecked = true;
+            if (contained && takesPointerEvents(item)) {
+                return item;
+            }
+        }
+        if (QQuickItem *hit = itemAt(*it, scenePosition)) {
+            return hit;
+        }
+    }
+
+    return !itemChecked && contained && takesPointerEvents(item) ? item : nullptr;
+}
+
+// Whether a press at scenePosition reaches listener, i.e. it contains the position,
+// isn't clipped away and no item stacked above it takes the press
+static bool isUnder(const PassiveMouseEventListener *listener, const QPointF &scenePosition)
+{
+    if (!listener->isVisible() || !listener->isEnabled() || !listener->contains(listener->mapFromScene(scenePosition))) {
+        return false;
+    }
+
+    const QQuickItem *item = listener;
+    for (const QQuickItem *parent = item->parentItem(); parent; item = parent, parent = parent->parentItem()) {
+        const bool contained = parent->contains(parent->mapFromScene(scenePosition));
+        if (parent->clip() && !contained) {
+            return false;
+        }
+        // Children with a negative z are below their parent
+        if (item->z() < 0 && contained && takesPointerEvents(parent)) {
+            return false;
+        }
+        const QList<QQuickItem *> siblings = parent->childItems();
+        const qsizetype index = siblings.indexOf(const_cast<QQuickItem *>(item));
+        for (qsizetype i = 0; i < siblings.size(); ++i) {
+            QQuickItem *sibling = siblings.at(i);
+            const bool above = sibling->z() > item->z() || (sibling->z() == item->z() && i > index);
+            if (above && itemAt(sibling, scenePosition)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+PassiveMouseEventRouter *PassiveMouseEventRouter::instance(QQuickWindow *window)
+{
+    auto *router = window->findChild<PassiveMouseEventRouter *>(QString(), Qt::FindDirectChildrenOnly);
+    if (!router) {
+        router = new PassiveMouseEventRouter(window);
+    }
+    return router;
+}
+
+PassiveMouseEventRouter::PassiveMouseEventRouter(QQuickWindow *window)
+    : QObject(window)
+    , m_window(window)
+{
+}
+
+void PassiveMouseEventRouter::add(PassiveMouseEventListener *listener)
+{
+    // Only filter the window while somebody listens
+    if (m_listeners.isEmpty()) {
+        m_window->installEventFilter(this);
+    }
+    m_listeners.append(listener);
+}
+
+void PassiveMouseEventRouter::remove(PassiveMouseEventListener *listener)
+{
+    m_listeners.removeOne(listener);
+    if (m_listeners.isEmpty()) {
+        m_window->removeEventFilter(this);
+    }
+}
+
+PassiveMouseEventRouter::Listeners PassiveMouseEventRouter::listenersAt(const QPointF &scenePosition) const
+{
+    Listeners listeners;
+    for (PassiveMouseEventListener *listener : m_listeners) {
+        if (isUnder(listener, scenePosition)) {
+            listeners.append(listener);
+        }
+    }
+
+    // Outermost first, nested listeners are the only ones which can be under the same position
+    const auto depth = [](const QQuickItem *item) {
+        int depth = 0;
+        for (; item; item = item->parentItem()) {
+            ++depth;
+        }
+        return depth;
+    };
+    std::sort(listeners.begin(), listeners.end(), [&depth](const PassiveMouseEventListener *a, const PassiveMouseEventListener *b) {
+        return depth(a) < depth(b);
+    });
+    return listeners;
+}
+
+bool PassiveMouseEventRouter::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched != m_window) {
+        return false;
+    }
+
+    switch (event->type()) {
+    case QEvent::MouseButtonPress: {
+        auto *me = static_cast<QMouseEvent *>(event);
+        return press(me->scenePosition(), me->globalPosition(), me->button(), me->buttons(), me->modifiers(), me->source());
+    }
+    case QEvent::MouseMove: {
+        auto *me = static_cast<QMouseEvent *>(event);
+        return move(me->scenePosition(), me->globalPosition(), me->buttons(), me->modifiers(), me->source());
+    }
+    case QEvent::MouseButtonRelease: {
+        auto *me = static_cast<QMouseEvent *>(event);
+        return release(me->scenePosition(), me->globalPosition(), me->button(), me->buttons(), me->modifiers(), me->source());
+    }
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd: {
+        auto *te = static_cast<QTouchEvent *>(event);
+        if (te->points().isEmpty()) {
+            break;
+        }
+        const QEventPoint &point = te->points().constFirst();
+        if (event->type() == QEvent::TouchBegin) {
+            return press(point.scenePosition(), point.globalPosition(), Qt::LeftButton, Qt::LeftButton, te->modifiers(), Qt::MouseEventSynthesizedByQt);
+        } else if (event->type() == QEvent::TouchUpdate) {
+            return move(point.scenePosition(), point.globalPosition(), Qt::LeftButton, te->modifiers(), Qt::MouseEventSynthesizedByQt);
+        }
+        return release(point.scenePosition(), point.globalPosition(), Qt::LeftButton, Qt::NoButton, te->modifiers(), Qt::MouseEventSynthesizedByQt);
+    }
+    case QEvent::TouchCancel: {
+        const Listeners listeners(m_listeners.cbegin(), m_listeners.cend());
+        for (const auto &listener : listeners) {
+            if (listener) {
+                listener->cancel();
+            }
+        }
+        break;
+    }
+    case QEvent::Wheel: {
+        auto *we = static_cast<QWheelEvent *>(event);
+        const Listeners listeners = listenersAt(we->scenePosition());
+        for (const auto &listener : listeners) {
+            if (listener) {
+                listener->wheel(we);
+            }
+        }
+        break;
+    }
+    case QEvent::Leave: {
+        const Listeners listeners(m_listeners.cbegin(), m_listeners.cend());
+        for (const auto &listener : listeners) {
+            if (listener) {
+                listener->leave();
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    return false;
+}
+
+bool PassiveMouseEventRouter::press(const QPointF &scenePosition,
+                                    const QPointF &globalPosition,
+                                    Qt::MouseButton button,
+                                    Qt::MouseButtons buttons,
+                                    Qt::KeyboardModifiers modifiers,
+                                    Qt::MouseEventSource source)
+{
+    const Listeners listeners = listenersAt(scenePosition);
+    for (const auto &listener : listeners) {
+        if (listener && listener->press(scenePosition, globalPosition, button, buttons, modifiers, source)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PassiveMouseEventRouter::move(const QPointF &scenePosition,
+                                   const QPointF &globalPosition,
+                                   Qt::MouseButtons buttons,
+                                   Qt::KeyboardModifiers modifiers,
+                                   Qt::MouseEventSource source)
+{
+    // Most moves are of no interest to anybody, skip hit testing for them
+    const bool followed = std::any_of(m_listeners.cbegin(), m_listeners.cend(), [](const PassiveMouseEventListener *listener) {
+        return listener->m_pressed || listener->m_hoverEnabled;
+    });
+    if (!followed) {
+        return false;
+    }
+
+    const Listeners listeners(m_listeners.cbegin(), m_listeners.cend());
+    bool accepted = false;
+    for (const auto &listener : listeners) {
+        if (listener && (listener->m_pressed || listener->m_hoverEnabled)) {
+            accepted |= listener->move(isUnder(listener, scenePosition), scenePosition, globalPosition, buttons, modifiers, source);
+        }
+    }
+    return accepted;
+}
+
+bool PassiveMouseEventRouter::release(const QPointF &scenePosition,
+                                      const QPointF &globalPosition,
+                                      Qt::MouseButton button,
+                                      Qt::MouseButtons buttons,
+                                      Qt::KeyboardModifiers modifiers,
+                                      Qt::MouseEventSource source)
+{
+    const bool pressed = std::any_of(m_listeners.cbegin(), m_listeners.cend(), [](const PassiveMouseEventListener *listener) {
+        return listener->m_pressed;
+    });
+    if (!pressed) {
+        return false;
+    }
+
+    const Listeners listeners(m_listeners.cbegin(), m_listeners.cend());
+    bool accepted = false;
+    for (const auto &listener : listeners) {
+        if (listener && listener->m_pressed) {
+            accepted |= listener->release(isUnder(listener, scenePosition), scenePosition, globalPosition, button, buttons, modifiers, source);
+        }
+    }
+    return accepted;
+}
+
+PassiveMouseEventListener::PassiveMouseEventListener(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    m_pressAndHoldTimer = new QTimer(this);
+    m_pressAndHoldTimer->setSingleShot(true);
+    connect(m_pressAndHoldTimer, &QTimer::timeout, this, [this]() {
+        if (m_pressed && m_pressAndHoldEvent) {
+            Q_EMIT pressAndHold(m_pressAndHoldEvent);
+        }
+    });
+}
+
+PassiveMouseEventListener::~PassiveMouseEventListener()
+{
+    setWindow(nullptr);
+    delete m_pressAndHoldEvent;
+}
+
+Qt::MouseButtons PassiveMouseEventListener::acceptedButtons() const
+{
+    return m_acceptedButtons;
+}
+
+void PassiveMouseEventListener::setAcceptedButtons(Qt::MouseButtons buttons)
+{
+    if (buttons == m_acceptedButtons) {
+        return;
+    }
+
+    m_acceptedButtons = buttons;
+    Q_EMIT acceptedButtonsChanged();
+}
+
+void PassiveMouseEventListener::setHoverEnabled(bool enable)
+{
+    if (enable == m_hoverEnabled) {
+        return;
+    }
+
+    m_hoverEnabled = enable;
+    if (!m_hoverEnabled && !m_pressed) {
+        setContainsMouse(false);
+    }
+    Q_EMIT hoverEnabledChanged(enable);
+}
+
+bool PassiveMouseEventListener::hoverEnabled() const
+{
+    return m_hoverEnabled;
+}
+
+bool PassiveMouseEventListener::isPressed() const
+{
+    return m_pressed;
+}
+
+bool PassiveMouseEventListener::containsMouse() const
+{
+    return m_containsMouse;
+}
+
+void PassiveMouseEventListener::setContainsMouse(bool contains)
+{
+    if (contains == m_containsMouse) {
+        return;
+    }
+
+    m_containsMouse = contains;
+    Q_EMIT containsMouseChanged(contains);
+}
+
+void PassiveMouseEventListener::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    switch (change) {
+    case ItemSceneChange:
+        setWindow(value.window);
+        break;
+    case ItemVisibleHasChanged:
+    case ItemEnabledHasChanged:
+        if (!value.boolValue) {
+            cancel();
+            setContainsMouse(false);
+        }
+        break;
+    default:
+        break;
+    }
+
+    QQuickItem::itemChange(change, value);
+}
+
+void PassiveMouseEventListener::setWindow(QQuickWindow *window)
+{
+    if (window == m_window) {
+        return;
+    }
+
+    if (m_window) {
+        PassiveMouseEventRouter::instance(m_window)->remove(this);
+    }
+    m_window = window;
+    if (m_window) {
+        PassiveMouseEventRouter::instance(m_window)->add(this);
+    }
+}
+
+bool PassiveMouseEventListener::press(const QPointF &scenePosition,
+                                      const QPointF &globalPosition,
+                                      Qt::MouseButton button,
+                                      Qt::MouseButtons buttons,
+                                      Qt::KeyboardModifiers modifiers,
+                                      Qt::MouseEventSource source)
+{
+    if (m_pressed || !(buttons & m_acceptedButtons)) {
+        return false;
+    }
+
+    const QPointF pos = mapFromScene(scenePosition);
+    QScreen *screen = QGuiApplication::screenAt(globalPosition.toPoint());
+    KDeclarativeMouseEvent dme(pos.x(), pos.y(), globalPosition.x(), globalPosition.y(), button, buttons, modifiers, screen, source);
+
+    delete m_pressAndHoldEvent;
+    m_pressAndHoldEvent = new KDeclarativeMouseEvent(pos.x(), pos.y(), globalPosition.x(), globalPosition.y(), button, buttons, modifiers, screen, source);
+
+    m_buttonDownPos = globalPosition;
+    m_pressed = true;
+    setContainsMouse(true);
+    Q_EMIT pressed(&dme);
+    Q_EMIT pressedChanged();
+
+    if (dme.isAccepted()) {
+        return true;
+    }
+
+    m_pressAndHoldTimer->start(QGuiApplication::styleHints()->mousePressAndHoldInterval());
+    return false;
+}
+
+bool PassiveMouseEventListener::move(bool under,
+                                     const QPointF &scenePosition,
+                                     const QPointF &globalPosition,
+                                     Qt::MouseButtons buttons,
+                                     Qt::KeyboardModifiers modifiers,
+                                     Qt::MouseEventSource source)
+{
+    const QPointF pos = mapFromScene(scenePosition);
+
+    if (!m_pressed) {
+        // Hovering
+        if (!m_hoverEnabled || buttons != Qt::NoButton) {
+            return false;
+        }
+        setContainsMouse(under);
+        if (!under) {
+            return false;
+        }
+        KDeclarativeMouseEvent dme(pos.x(), pos.y(), globalPosition.x(), globalPosition.y(), Qt::NoButton, Qt::NoButton, modifiers, nullptr, source);
+        Q_EMIT positionChanged(&dme);
+        return dme.isAccepted();
+    }
+
+    if (!(buttons & m_acceptedButtons)) {
+        return false;
+    }
+
+    QScreen *screen = QGuiApplication::screenAt(globalPosition.toPoint());
+
+    if (QPointF(globalPosition - m_buttonDownPos).manhattanLength() > QGuiApplication::styleHints()->startDragDistance()
+        && m_pressAndHoldTimer->isActive()) {
+        m_pressAndHoldTimer->stop();
+    } else if (m_pressAndHoldEvent) {
+        // There is no way to update the event, replace it with one at the new position
+        delete m_pressAndHoldEvent;
+        m_pressAndHoldEvent = new KDeclarativeMouseEvent(pos.x(), pos.y(), globalPosition.x(), globalPosition.y(), Qt::NoButton, buttons, modifiers, screen, source);
+    }
+
+    if (m_hoverEnabled) {
+        setContainsMouse(under);
+    }
+
+    KDeclarativeMouseEvent dme(pos.x(), pos.y(), globalPosition.x(), globalPosition.y(), Qt::NoButton, buttons, modifiers, screen, source);
+    Q_EMIT positionChanged(&dme);
+    return dme.isAccepted();
+}
+
+bool PassiveMouseEventListener::release(bool under,
+                                        const QPointF &scenePosition,
+                                        const QPointF &globalPosition,
+                                        Qt::MouseButton button,
+                                        Qt::MouseButtons buttons,
+                                        Qt::KeyboardModifiers modifiers,
+                                        Qt::MouseEventSource source)
+{
+    if (!m_pressed) {
+        return false;
+    }
+
+    const QPointF pos = mapFromScene(scenePosition);
+    KDeclarativeMouseEvent
+        dme(pos.x(), pos.y(), globalPosition.x(), globalPosition.y(), button, buttons, modifiers, QGuiApplication::screenAt(globalPosition.toPoint()), source);
+
+    m_pressed = false;
+    Q_EMIT released(&dme);
+    Q_EMIT pressedChanged();
+
+    if (under && m_pressAndHoldTimer->isActive()) {
+        Q_EMIT clicked(&dme);
+    }
+    m_pressAndHoldTimer->stop();
+
+    if (!m_hoverEnabled || !under) {
+        setContainsMouse(false);
+    }
+
+    return dme.isAccepted();
+}
+
+void PassiveMouseEventListener::wheel(const QWheelEvent *event)
+{
+    KDeclarativeWheelEvent dwe(mapFromScene(event->scenePosition()),
+                               event->globalPosition().toPoint(),
+                               event->angleDelta(),
+                               event->buttons(),
+                               event->modifiers(),
+                               Qt::Vertical /* HACK, deprecated, remove */);
+    Q_EMIT wheelMoved(&dwe);
+}
+
+void PassiveMouseEventListener::leave()
+{
+    if (!m_pressed) {
+        setContainsMouse(false);
+    }
+}
+
+void PassiveMouseEventListener::cancel()
+{
+    if (!m_pressed) {
+        return;
+    }
+
+    m_pressAndHoldTimer->stop();
+    m_pressed = false;
+    Q_EMIT pressedChanged();
+    Q_EMIT canceled();
+}
+
+#include "moc_passivemouseeventlistener.cpp"
+#include "passivemouseeventlistener.moc"
@@ -0,0 +1,118 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef PASSIVEMOUSEEVENTLISTENER_H
+#define PASSIVEMOUSEEVENTLISTENER_H
+
+#include <QPointer>
+#include <QQuickItem>
+
+#include "mouseeventlistener.h"
+
+class PassiveMouseEventRouter;
+class QTimer;
+class QQuickWindow;
+class QWheelEvent;
+
+/**
+ * A lighter MouseEventListener: it observes the mouse, touch and wheel events of its area,
+ * including the ones delivered to children, with the same signals and event objects.
+ *
+ * Instead of filtering the events of all children with childMouseEventFilter(), which
+ * Qt Quick runs for every event and for every listener in the ancestor chain, it watches
+ * the events once as they arrive at the window: all the listeners of a window share a
+ * single event filter, which hit tests only the listeners of the window and hands the
+ * event to the ones containing the position. An item stacked above the listener hides
+ * it, as it would from MouseEventListener. Pointer handlers are not seen by this check,
+ * only items accepting mouse or touch events. Moves are only looked at while a listener
+ * is pressed or has hoverEnabled set.
+ *
+ * Like a passive grab of a pointer handler, a press inside the item is followed until
+ * the release, even outside of it.
+ *
+ * Setting accepted on the event of pressed, positionChanged or released stops the
+ * event from being delivered to the items, like with MouseEventListener. Touch events
+ * are reported for their first touch point, with source Qt.MouseEventSynthesizedByQt.
+ *
+ * @since 6.0
+ */
+class PassiveMouseEventListener : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    /**
+     * This property holds whether hover events are handled.
+     * By default hover events are disabled
+     */
+    Q_PROPERTY(bool hoverEnabled READ hoverEnabled WRITE setHoverEnabled NOTIFY hoverEnabledChanged)
+
+    /**
+     * True if the mouse cursor is inside this item:
+     * this property will change only when the mouse button is pressed if hoverEnabled is false.
+     */
+    Q_PROPERTY(bool containsMouse READ containsMouse NOTIFY containsMouseChanged)
+
+    Q_PROPERTY(Qt::MouseButtons acceptedButtons READ acceptedButtons WRITE setAcceptedButtons NOTIFY acceptedButtonsChanged)
+
+    /**
+     * True if the mouse is pressed in the item or any of its children
+     */
+    Q_PROPERTY(bool pressed READ isPressed NOTIFY pressedChanged)
+
+public:
+    explicit PassiveMouseEventListener(QQuickItem *parent = nullptr);
+    ~PassiveMouseEventListener() override;
+
+    bool containsMouse() const;
+    void setHoverEnabled(bool enable);
+    bool hoverEnabled() const;
+    bool isPressed() const;
+
+    Qt::MouseButtons acceptedButtons() const;
+    void setAcceptedButtons(Qt::MouseButtons buttons);
+
+protected:
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+Q_SIGNALS:
+    void pressed(KDeclarativeMouseEvent *mouse);
+    void positionChanged(KDeclarativeMouseEvent *mouse);
+    void released(KDeclarativeMouseEvent *mouse);
+    void clicked(KDeclarativeMouseEvent *mouse);
+    void pressAndHold(KDeclarativeMouseEvent *mouse);
+    void wheelMoved(KDeclarativeWheelEvent *wheel);
+    void containsMouseChanged(bool containsMouseChanged);
+    void hoverEnabledChanged(bool hoverEnabled);
+    void acceptedButtonsChanged();
+    void pressedChanged();
+    void canceled();
+
+private:
+    friend class PassiveMouseEventRouter;
+
+    void setWindow(QQuickWindow *window);
+    void setContainsMouse(bool contains);
+
+    // Called by the router of the window, under tells whether the event is for this listener's subtree
+    bool press(const QPointF &scenePosition, const QPointF &globalPosition, Qt::MouseButton button, Qt::MouseButtons buttons, Qt::KeyboardModifiers modifiers, Qt::MouseEventSource source);
+    bool move(bool under, const QPointF &scenePosition, const QPointF &globalPosition, Qt::MouseButtons buttons, Qt::KeyboardModifiers modifiers, Qt::MouseEventSource source);
+    bool release(bool under, const QPointF &scenePosition, const QPointF &globalPosition, Qt::MouseButton button, Qt::MouseButtons buttons, Qt::KeyboardModifiers modifiers, Qt::MouseEventSource source);
+    void wheel(const QWheelEvent *event);
+    void leave();
+    void cancel();
+
+    QPointer<QQuickWindow> m_window;
+    QTimer *m_pressAndHoldTimer;
+    KDeclarativeMouseEvent *m_pressAndHoldEvent = nullptr;
+    QPointF m_buttonDownPos;
+    Qt::MouseButtons m_acceptedButtons = Qt::LeftButton;
+    bool m_hoverEnabled = false;
+    bool m_pressed = false;
+    bool m_containsMouse = false;
+};
+
+#endif
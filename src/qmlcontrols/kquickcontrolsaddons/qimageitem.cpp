@@ -6,26 +6,145 @@
 */
 
 #include "qimageitem.h"
+#include "adaptivequality.h"
+#include "blurhash.h"
+#include "imageanalysis.h"
+#include "imagedecodescheduler.h"
+#include "imagepyramiditem.h"
+#include "imageuploadscheduler.h"
 
+#include <QGuiApplication>
+#include <QMatrix4x4>
 #include <QPainter>
+#include <QPointer>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QQuickWindow>
+#include <QSGImageNode>
+#include <QSGNode>
+#include <QSGTransformNode>
+#include <QThreadPool>
+#include <QVariantAnimation>
+
+#include <tuple>
+
+namespace
+{
+// Maps the pixels of an image of size @p size to their position after applying @p orientation
+QTransform orientationTransform(QImageIOHandler::Transformations orientation, const QSize &size)
+{
+    // Mirroring and flipping come first, then the rotation, like in QImageReader
+    const bool mirror = orientation & QImageIOHandler::TransformationMirror;
+    const bool flip = orientation & QImageIOHandler::TransformationFlip;
+    QTransform transform(mirror ? -1 : 1, 0, 0, flip ? -1 : 1, mirror ? size.width() : 0, flip ? size.height() : 0);
+
+    if (orientation & QImageIOHandler::TransformationRotate90) {
+        transform *= QTransform(0, 1, -1, 0, size.height(), 0);
+    }
+
+    return transform;
+}
+
+// The size of an image of size @p size once @p orientation is applied
+QSize orientedSize(QImageIOHandler::Transformations orientation, const QSize &size)
+{
+    return orientation & QImageIOHandler::TransformationRotate90 ? size.transposed() : size;
+}
+
+QImageIOHandler::Transformations transformationFromExif(int orientation)
+{
+    switch (orientation) {
+    case 2:
+        return QImageIOHandler::TransformationMirror;
+    case 3:
+        return QImageIOHandler::TransformationRotate180;
+    case 4:
+        return QImageIOHandler::TransformationFlip;
+    case 5:
+        return QImageIOHandler::TransformationFlipAndRotate90;
+    case 6:
+        return QImageIOHandler::TransformationRotate90;
+    case 7:
+        return QImageIOHandler::TransformationMirrorAndRotate90;
+    case 8:
+        return QImageIOHandler::TransformationRotate270;
+    default:
+        return QImageIOHandler::TransformationNone;
+    }
+}
+
+// Shows the part of a texture of @p textureSize covering @p rect that is inside @p clip
+void setVisibleRect(QSGImageNode *node, const QRectF &rect, const QSize &textureSize, const QRectF &clip)
+{
+    const QRectF visible = rect & clip;
+    const qreal sx = textureSize.width() / rect.width();
+    const qreal sy = textureSize.height() / rect.height();
+    node->setRect(visible);
+    node->setSourceRect(QRectF((visible.x() - rect.x()) * sx, (visible.y() - rect.y()) * sy, visible.width() * sx, visible.height() * sy));
+}
+
+int exifFromTransformation(QImageIOHandler::Transformations transformation)
+{
+    for (int orientation = 2; orientation <= 8; ++orientation) {
+        if (transformationFromExif(orientation) == transformation) {
+            return orientation;
+        }
+    }
+    return 1;
+}
+}
+
+// Renders an oriented image with the scene graph, the orientation being the matrix of the
+// transform node, along with the placeholder it fades in over
+class OrientedImageNode : public QSGNode
+{
+public:
+    QSGImageNode *placeholder = nullptr;
+    qint64 placeholderKey = 0;
+    QSGOpacityNode *opacity = nullptr;
+    QSGTransformNode *transform = nullptr;
+    QSGImageNode *image = nullptr;
+    qint64 imageKey = 0;
+};
 
 QImageItem::QImageItem(QQuickItem *parent)
     : QQuickPaintedItem(parent)
     , m_fillMode(QImageItem::Stretch)
+    , m_adaptiveQuality(new AdaptiveQuality(this))
 {
     setFlag(ItemHasContents, true);
+    connect(m_adaptiveQuality, &AdaptiveQuality::settled, this, &QImageItem::updatePrescaledImage);
+    connect(m_adaptiveQuality, &AdaptiveQuality::changed, this, [this]() {
+        update();
+    });
 }
 
 QImageItem::~QImageItem()
 {
+    cancelDecode();
+    delete m_pendingFrame.loadAcquire();
 }
 
 void QImageItem::setImage(const QImage &image)
+{
+    // Scanned once here rather than on every paint
+    replaceImage(image, ImageAnalysis::isOpaque(image));
+}
+
+void QImageItem::replaceImage(const QImage &image, bool opaque)
 {
     bool oldImageNull = m_image.isNull();
     m_image = image;
-    updatePaintedRect();
-    update();
+    m_imageOpaque = opaque;
+    m_colorsValid = false;
+    if (m_colorsUsed) {
+        extractColors();
+    }
+    if (m_pyramid) {
+        m_pyramid->setImage(m_image, m_imageOpaque);
+    }
+    // Updates the painted rect along with the painted image, right away or once it's our turn
+    scheduleUpload();
     Q_EMIT nativeWidthChanged();
     Q_EMIT nativeHeightChanged();
     Q_EMIT imageChanged();
@@ -46,12 +165,12 @@ void QImageItem::resetImage()
 
 int QImageItem::nativeWidth() const
 {
-    return m_image.size().width() / m_image.devicePixelRatio();
+    return orientedSize().width() / m_image.devicePixelRatio();
 }
 
 int QImageItem::nativeHeight() const
 {
-    return m_image.size().height() / m_image.devicePixelRatio();
+    return orientedSize().height() / m_image.devicePixelRatio();
 }
 
 QImageItem::FillMode QImageItem::fillMode() const
@@ -66,39 +185,528 @@ void QImageItem::setFillMode(QImageItem::FillMode mode)
     }
 
     m_fillMode = mode;
+    updateOpaquePainting();
+    updatePyramid();
     updatePaintedRect();
     update();
     Q_EMIT fillModeChanged();
 }
 
+bool QImageItem::isTiled() const
+{
+    return m_tiled;
+}
+
+void QImageItem::setTiled(bool tiled)
+{
+    if (tiled == m_tiled) {
+        return;
+    }
+
+    m_tiled = tiled;
+    updatePyramid();
+    updatePaintedRect();
+    Q_EMIT tiledChanged();
+}
+
+bool QImageItem::deferredUpload() const
+{
+    return m_deferredUpload;
+}
+
+void QImageItem::setDeferredUpload(bool deferred)
+{
+    if (deferred == m_deferredUpload) {
+        return;
+    }
+
+    m_deferredUpload = deferred;
+    if (!m_deferredUpload && m_uploadPending) {
+        scheduleUpload();
+    }
+    Q_EMIT deferredUploadChanged();
+}
+
+QUrl QImageItem::source() const
+{
+    return m_source;
+}
+
+void QImageItem::setSource(const QUrl &source)
+{
+    if (source == m_source) {
+        return;
+    }
+
+    m_source = source;
+    updateSource();
+    Q_EMIT sourceChanged();
+}
+
+QSize QImageItem::sourceSize() const
+{
+    return m_sourceSize;
+}
+
+void QImageItem::setSourceSize(const QSize &size)
+{
+    if (size == m_sourceSize) {
+        return;
+    }
+
+    m_sourceSize = size;
+    if (!m_source.isEmpty() || !m_sources.isEmpty()) {
+        loadSource();
+    }
+    Q_EMIT sourceSizeChanged();
+}
+
+QVariantList QImageItem::sources() const
+{
+    return m_sources;
+}
+
+void QImageItem::setSources(const QVariantList &sources)
+{
+    if (sources == m_sources) {
+        return;
+    }
+
+    m_sources = sources;
+    updateSource();
+    Q_EMIT sourcesChanged();
+}
+
+void QImageItem::updateSource()
+{
+    if (m_source.isEmpty() && m_sources.isEmpty()) {
+        cancelDecode();
+        m_sourcePending = false;
+        resetImage();
+    } else {
+        loadSource();
+    }
+}
+
+std::pair<QUrl, qreal> QImageItem::selectSource(const QVariantList &sources, qreal dpr, qreal width)
+{
+    struct Candidate {
+        QUrl source;
+        qreal scale;
+        int width;
+        bool scaleGiven;
+    };
+    QList<Candidate> candidates;
+    bool haveWidths = true;
+
+    for (const QVariant &entry : sources) {
+        const QVariantMap map = entry.toMap();
+        const QUrl source = map.value(QStringLiteral("source")).toUrl();
+        const qreal scale = map.value(QStringLiteral("scale"), 1.0).toReal();
+        if (source.isEmpty() || scale <= 0) {
+            continue;
+        }
+        const int width = map.value(QStringLiteral("width"), 0).toInt();
+        haveWidths &= width > 0;
+        candidates.append({source, scale, width, map.contains(QStringLiteral("scale"))});
+    }
+
+    if (candidates.isEmpty()) {
+        return {QUrl(), 0};
+    }
+
+    const Candidate *best = nullptr;
+    if (haveWidths && width > 0) {
+        // The narrowest variant still covering the width in device pixels, otherwise the widest one
+        const qreal wanted = width * dpr;
+        for (const Candidate &candidate : std::as_const(candidates)) {
+            const bool covers = candidate.width >= wanted;
+            const bool bestCovers = best && best->width >= wanted;
+            if (!best || (covers && (!bestCovers || candidate.width < best->width)) || (!covers && !bestCovers && candidate.width > best->width)) {
+                best = &candidate;
+            }
+        }
+        // Shown at the scale of the screen, unless the variant says what it was made for
+        return {best->source, best->scaleGiven ? best->scale : dpr};
+    }
+
+    for (const Candidate &candidate : std::as_const(candidates)) {
+        // The smallest variant which is still sharp, otherwise the sharpest one
+        const bool sharp = candidate.scale >= dpr;
+        const bool bestSharp = best && best->scale >= dpr;
+        if (!best || (sharp && (!bestSharp || candidate.scale < best->scale)) || (!sharp && !bestSharp && candidate.scale > best->scale)) {
+            best = &candidate;
+        }
+    }
+    return {best->source, best->scale};
+}
+
+qreal QImageItem::sourceSelectionWidth() const
+{
+    return m_sourceSize.width() > 0 ? m_sourceSize.width() : width();
+}
+
+void QImageItem::loadSource()
+{
+    cancelDecode();
+
+    if (!isVisible() || !window()) {
+        m_sourcePending = true;
+        return;
+    }
+
+    m_sourcePending = false;
+    m_sourceDpr = window()->effectiveDevicePixelRatio();
+
+    QUrl source = m_source;
+    // Without a size to fit the image is used at its natural size, as made for its scale
+    qreal scale = 1;
+    if (!m_sources.isEmpty()) {
+        std::tie(m_selectedSource, scale) = selectSource(m_sources, m_sourceDpr, sourceSelectionWidth());
+        // Plain strings in a JavaScript object are not resolved against the document by the engine
+        const QQmlContext *context = qmlContext(this);
+        source = context && !m_selectedSource.isEmpty() ? context->resolvedUrl(m_selectedSource) : m_selectedSource;
+    }
+    if (ImageDecodeScheduler::isScaledSize(m_sourceSize)) {
+        scale = m_sourceDpr;
+    }
+
+    if (source.isEmpty()) {
+        return;
+    }
+
+    // The pixels are never transformed, the orientation from the metadata is applied when drawing
+    const auto mode = m_autoTransform ? ImageDecodeScheduler::ReportTransformation : ImageDecodeScheduler::IgnoreTransformation;
+    m_decodeTicket = ImageDecodeScheduler::instance()->request(source, m_sourceSize, scale, mode, this, [this](const QImage &image, QImageIOHandler::Transformations transformation) {
+        m_decodeTicket = 0;
+        // After the image, so a deferred upload picks up the orientation together with it
+        setImage(image);
+        if (m_autoTransform) {
+            setTransformation(transformation);
+            m_orientationFromSource = true;
+        }
+    });
+}
+
+void QImageItem::cancelDecode()
+{
+    if (m_decodeTicket) {
+        ImageDecodeScheduler::instance()->cancel(m_decodeTicket);
+        m_decodeTicket = 0;
+    }
+}
+
+bool QImageItem::adaptiveQuality() const
+{
+    return m_adaptiveQuality->isEnabled();
+}
+
+void QImageItem::setAdaptiveQuality(bool adaptive)
+{
+    if (adaptive == m_adaptiveQuality->isEnabled()) {
+        return;
+    }
+
+    m_adaptiveQuality->setEnabled(adaptive);
+    updatePrescaledImage();
+    update();
+    Q_EMIT adaptiveQualityChanged();
+}
+
+void QImageItem::updatePrescaledImage()
+{
+    // Only unrotated, untiled images. Done here rather than in paint(), which runs
+    // on the render thread for every frame.
+    if (m_pyramid || m_fillMode >= Tile || m_paintedOrientation != QImageIOHandler::TransformationNone) {
+        m_adaptiveQuality->prescale(QImage(), 0, QSize());
+        return;
+    }
+
+    const qreal scale = window() ? window()->effectiveDevicePixelRatio() : 1;
+    m_adaptiveQuality->prescale(m_paintedImage, m_paintedImage.cacheKey(), (QSizeF(m_paintedRect.size()) * scale).toSize());
+}
+
+void QImageItem::scheduleUpload()
+{
+    if (!m_deferredUpload || m_pyramid || !window()) {
+        if (m_uploadPending && window()) {
+            ImageUploadScheduler::instance(window())->cancel(this);
+        }
+        m_uploadPending = false;
+        updatePaintedImage();
+        return;
+    }
+
+    m_uploadPending = true;
+    ImageUploadScheduler::instance(window())->schedule(this, [this] {
+        m_uploadPending = false;
+        updatePaintedImage();
+    });
+}
+
+int QImageItem::orientation() const
+{
+    return exifFromTransformation(m_orientation);
+}
+
+void QImageItem::setOrientation(int orientation)
+{
+    m_orientationFromSource = false;
+    setTransformation(transformationFromExif(orientation));
+}
+
+void QImageItem::setTransformation(QImageIOHandler::Transformations transformation)
+{
+    if (transformation == m_orientation) {
+        return;
+    }
+
+    const bool sizeChanged = (transformation ^ m_orientation) & QImageIOHandler::TransformationRotate90;
+    m_orientation = transformation;
+    // The image still shown while an upload is pending keeps its own orientation
+    if (!m_uploadPending) {
+        m_paintedOrientation = m_orientation;
+        updatePaintedRect();
+        update();
+    }
+    if (sizeChanged) {
+        Q_EMIT nativeWidthChanged();
+        Q_EMIT nativeHeightChanged();
+    }
+    Q_EMIT orientationChanged();
+}
+
+bool QImageItem::autoTransform() const
+{
+    return m_autoTransform;
+}
+
+void QImageItem::setAutoTransform(bool autoTransform)
+{
+    if (autoTransform == m_autoTransform) {
+        return;
+    }
+
+    m_autoTransform = autoTransform;
+    // Drop the orientation read from the metadata, not one set explicitly
+    if (!m_autoTransform && m_orientationFromSource) {
+        m_orientationFromSource = false;
+        setTransformation(QImageIOHandler::TransformationNone);
+    }
+    if (!m_source.isEmpty() || !m_sources.isEmpty()) {
+        loadSource();
+    }
+    Q_EMIT autoTransformChanged();
+}
+
+QSize QImageItem::orientedSize() const
+{
+    return ::orientedSize(m_orientation, m_image.size());
+}
+
+QColor QImageItem::dominantColor() const
+{
+    const_cast<QImageItem *>(this)->extractColors();
+    return m_palette.value(0);
+}
+
+QColor QImageItem::averageColor() const
+{
+    const_cast<QImageItem *>(this)->extractColors();
+    return m_averageColor;
+}
+
+QVariantList QImageItem::palette() const
+{
+    const_cast<QImageItem *>(this)->extractColors();
+
+    QVariantList palette;
+    palette.reserve(m_palette.size());
+    for (const QColor &color : m_palette) {
+        palette.append(color);
+    }
+    return palette;
+}
+
+void QImageItem::extractColors()
+{
+    m_colorsUsed = true;
+    if (m_colorsValid) {
+        return;
+    }
+    m_colorsValid = true;
+
+    // Results of previous images still being computed are thrown away
+    const quint64 generation = ++m_colorsGeneration;
+    QThreadPool::globalInstance()->start([item = QPointer<QImageItem>(this), image = m_image, generation]() {
+        const ImageAnalysis::Colors colors = ImageAnalysis::extractColors(image, 5);
+        QMetaObject::invokeMethod(qApp, [item, colors, generation]() {
+            if (!item || item->m_colorsGeneration != generation) {
+                return;
+            }
+            item->m_averageColor = colors.average;
+            item->m_palette = colors.palette;
+            Q_EMIT item->colorsChanged();
+        });
+    });
+}
+
+QTransform QImageItem::imageTransform() const
+{
+    const QSize size = ::orientedSize(m_paintedOrientation, m_paintedImage.size());
+    const QTransform orientation = orientationTransform(m_paintedOrientation, m_paintedImage.size());
+
+    if (m_fillMode == Pad) {
+        const QPoint offset = m_paintedRect.center() - QRect(QPoint(0, 0), size).center();
+        return orientation * QTransform::fromTranslate(offset.x(), offset.y());
+    }
+
+    QTransform transform;
+    transform.translate(m_paintedRect.x(), m_paintedRect.y());
+    transform.scale(m_paintedRect.width() / qreal(size.width()), m_paintedRect.height() / qreal(size.height()));
+    return orientation * transform;
+}
+
+void QImageItem::updatePyramid()
+{
+    const bool usePyramid = m_tiled && m_fillMode != Tile && m_fillMode != TileVertically && m_fillMode != TileHorizontally;
+
+    if (!usePyramid) {
+        if (m_pyramid) {
+            delete m_pyramid;
+            m_pyramid = nullptr;
+            setFlag(ItemHasContents, true);
+            update();
+        }
+        return;
+    }
+
+    if (m_pyramid) {
+        return;
+    }
+
+    // The tiles are rendered by a child item, drop our own texture which would be as big as the item
+    update();
+    setFlag(ItemHasContents, false);
+
+    m_pyramid = new ImagePyramidItem(this);
+    m_pyramid->setSize(size());
+    m_pyramid->setSmooth(smooth());
+    m_pyramid->setImage(m_image, m_imageOpaque);
+    connect(this, &QQuickItem::smoothChanged, m_pyramid, &QQuickItem::setSmooth);
+
+    // Tiles are never deferred, show the new image right away
+    if (m_uploadPending) {
+        scheduleUpload();
+    }
+}
+
+void QImageItem::updatePaintedImage()
+{
+    const bool replacesPlaceholder = m_paintedImage.isNull() && !m_image.isNull() && !m_placeholderImage.isNull();
+
+    m_paintedImage = m_image;
+    m_paintedOrientation = m_orientation;
+    updateOpaquePainting();
+    updatePaintedRect();
+    update();
+
+    if (replacesPlaceholder) {
+        // Fade the image in over the placeholder rather than popping it in
+        if (!m_crossfadeAnimation) {
+            m_crossfadeAnimation = new QVariantAnimation(this);
+            m_crossfadeAnimation->setDuration(150);
+            m_crossfadeAnimation->setStartValue(0.0);
+            m_crossfadeAnimation->setEndValue(1.0);
+            connect(m_crossfadeAnimation, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
+                m_crossfade = value.toReal();
+                update();
+            });
+        }
+        m_crossfade = 0;
+        m_crossfadeAnimation->start();
+    }
+}
+
+QString QImageItem::placeholder() const
+{
+    return m_placeholder;
+}
+
+void QImageItem::setPlaceholder(const QString &placeholder)
+{
+    if (placeholder == m_placeholder) {
+        return;
+    }
+
+    m_placeholder = placeholder;
+    m_placeholderImage = BlurHash::decode(m_placeholder);
+    if (m_paintedImage.isNull()) {
+        update();
+    }
+    Q_EMIT placeholderChanged();
+}
+
+void QImageItem::updateOpaquePainting()
+{
+    // Lets the renderer draw the item in its opaque batch, without blending and
+    // hiding what is below, but only if the image covers all of the item
+    const bool coversItem = m_fillMode != PreserveAspectFit && m_fillMode != Pad;
+    setOpaquePainting(m_imageOpaque && coversItem && m_paintedImage.cacheKey() == m_image.cacheKey());
+}
+
 void QImageItem::paint(QPainter *painter)
 {
-    if (m_image.isNull()) {
+    if (m_pyramid || (m_paintedImage.isNull() && m_placeholderImage.isNull())) {
         return;
     }
     painter->save();
-    painter->setRenderHint(QPainter::Antialiasing, smooth());
-    painter->setRenderHint(QPainter::SmoothPixmapTransform, smooth());
+    // While resizing, trade quality for speed, nobody can tell the difference at that point
+    const bool smoothPainting = smooth() && !m_adaptiveQuality->isResizing();
+    painter->setRenderHint(QPainter::Antialiasing, smoothPainting);
+
+    if (!m_placeholderImage.isNull() && (m_paintedImage.isNull() || m_crossfade < 1)) {
+        // Bilinear upscaling of the tiny placeholder blurs it
+        painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+        painter->drawImage(placeholderRect(), m_placeholderImage);
+        if (m_paintedImage.isNull()) {
+            painter->restore();
+            return;
+        }
+        painter->setOpacity(m_crossfade);
+    }
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, smoothPainting);
+
+    const QSize orientedSize = ::orientedSize(m_paintedOrientation, m_paintedImage.size());
 
     if (m_fillMode == TileVertically) {
-        painter->scale(width() / (qreal)m_image.width(), 1);
+        painter->scale(width() / (qreal)orientedSize.width(), 1);
     }
 
     if (m_fillMode == TileHorizontally) {
-        painter->scale(1, height() / (qreal)m_image.height());
+        painter->scale(1, height() / (qreal)orientedSize.height());
     }
 
-    if (m_fillMode == Pad) {
+    if (m_paintedOrientation != QImageIOHandler::TransformationNone) {
+        // Only the tiling fill modes get here, see updateOrientedNode(). The pixels in memory are never touched.
+        QBrush brush(m_paintedImage);
+        brush.setTransform(orientationTransform(m_paintedOrientation, m_paintedImage.size()) * QTransform::fromScale(1 / m_paintedImage.devicePixelRatio(), 1 / m_paintedImage.devicePixelRatio()));
+        painter->fillRect(m_paintedRect, brush);
+    } else if (m_fillMode == Pad) {
         QRect centeredRect = m_paintedRect;
-        centeredRect.moveCenter(m_image.rect().center());
-        painter->drawImage(m_paintedRect, m_image, centeredRect);
+        centeredRect.moveCenter(m_paintedImage.rect().center());
+        painter->drawImage(m_paintedRect, m_paintedImage, centeredRect);
     } else if (m_fillMode >= Tile) {
-        painter->drawTiledPixmap(m_paintedRect, QPixmap::fromImage(m_image));
+        painter->drawTiledPixmap(m_paintedRect, QPixmap::fromImage(m_paintedImage));
     } else {
-        painter->drawImage(m_paintedRect, m_image, m_image.rect());
+        const QImage prescaled = smoothPainting ? m_adaptiveQuality->prescaled(m_paintedImage.cacheKey()) : QImage();
+        const QImage &image = prescaled.isNull() ? m_paintedImage : prescaled;
+        painter->drawImage(m_paintedRect, image, image.rect());
     }
 
     painter->restore();
+    m_adaptiveQuality->setFramePainted(!m_paintedRect.isEmpty());
 }
 
 bool QImageItem::isNull() const
@@ -108,7 +716,7 @@ bool QImageItem::isNull() const
 
 int QImageItem::paintedWidth() const
 {
-    if (m_image.isNull()) {
+    if (m_paintedImage.isNull()) {
         return 0;
     }
 
@@ -117,26 +725,22 @@ int QImageItem::paintedWidth() const
 
 int QImageItem::paintedHeight() const
 {
-    if (m_image.isNull()) {
+    if (m_paintedImage.isNull()) {
         return 0;
     }
 
     return m_paintedRect.height();
 }
 
-void QImageItem::updatePaintedRect()
+QRectF QImageItem::calculatePaintedRect() const
 {
-    if (m_image.isNull()) {
-        return;
-    }
-
-    QRectF sourceRect = m_paintedRect;
-
+    // Of what is painted, which lags behind m_image while a deferred upload is pending
+    const QSize orientedSize = ::orientedSize(m_paintedOrientation, m_paintedImage.size());
     QRectF destRect;
 
     switch (m_fillMode) {
     case PreserveAspectFit: {
-        QSizeF scaled = m_image.size();
+        QSizeF scaled = orientedSize;
 
         scaled.scale(boundingRect().size(), Qt::KeepAspectRatio);
         destRect = QRectF(QPoint(0, 0), scaled);
@@ -144,7 +748,7 @@ void QImageItem::updatePaintedRect()
         break;
     }
     case PreserveAspectCrop: {
-        QSizeF scaled = m_image.size();
+        QSizeF scaled = orientedSize;
 
         scaled.scale(boundingRect().size(), Qt::KeepAspectRatioByExpanding);
         destRect = QRectF(QPoint(0, 0), scaled);
@@ -153,12 +757,12 @@ void QImageItem::updatePaintedRect()
     }
     case TileVertically: {
         destRect = boundingRect().toRect();
-        destRect.setWidth(destRect.width() / (width() / (qreal)m_image.width()));
+        destRect.setWidth(destRect.width() / (width() / (qreal)orientedSize.width()));
         break;
     }
     case TileHorizontally: {
         destRect = boundingRect().toRect();
-        destRect.setHeight(destRect.height() / (height() / (qreal)m_image.height()));
+        destRect.setHeight(destRect.height() / (height() / (qreal)orientedSize.height()));
         break;
     }
     case Stretch:
@@ -168,16 +772,265 @@ void QImageItem::updatePaintedRect()
         destRect = boundingRect().toRect();
     }
 
+    return destRect;
+}
+
+QRectF QImageItem::placeholderRect() const
+{
+    // Where the image is, or will be as far as its size is known before it arrives
+    QSizeF size;
+    if (!m_paintedImage.isNull()) {
+        if (m_fillMode != Pad) {
+            return m_fillMode >= Tile ? boundingRect() : QRectF(m_paintedRect);
+        }
+        size = ::orientedSize(m_paintedOrientation, m_paintedImage.size());
+    } else if (m_sourceSize.width() > 0 && m_sourceSize.height() > 0) {
+        size = m_sourceSize;
+    }
+
+    if (size.isEmpty()) {
+        return boundingRect();
+    }
+
+    switch (m_fillMode) {
+    case PreserveAspectFit:
+        size.scale(boundingRect().size(), Qt::KeepAspectRatio);
+        break;
+    case PreserveAspectCrop:
+        size.scale(boundingRect().size(), Qt::KeepAspectRatioByExpanding);
+        break;
+    case Pad:
+        break;
+    default:
+        return boundingRect();
+    }
+
+    QRectF rect(QPointF(0, 0), size);
+    rect.moveCenter(boundingRect().center());
+    return rect;
+}
+
+void QImageItem::updatePaintedRect()
+{
+    if (m_paintedImage.isNull()) {
+        return;
+    }
+
+    QRectF sourceRect = m_paintedRect;
+
+    QRectF destRect = calculatePaintedRect();
+
     if (destRect != sourceRect) {
         m_paintedRect = destRect.toRect();
         Q_EMIT paintedHeightChanged();
         Q_EMIT paintedWidthChanged();
     }
+
+    if (m_pyramid) {
+        m_pyramid->setImageTransform(imageTransform());
+    }
+
+    updatePrescaledImage();
+}
+
+void QImageItem::presentFrame(const QImage &frame)
+{
+    // Latest frame wins, a frame the renderer didn't pick up yet is dropped.
+    // The opacity scan runs here, on the producer's thread, not on the render thread.
+    delete m_pendingFrame.fetchAndStoreOrdered(new Frame{frame, ImageAnalysis::isOpaque(frame)});
+
+    // QQuickItem::update() is only allowed on the gui thread, wake it up once for any number of frames
+    if (!m_frameUpdateQueued.testAndSetOrdered(0, 1)) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            m_frameUpdateQueued.storeRelease(0);
+            if (m_pyramid) {
+                // The tiles are managed on the gui thread
+                if (Frame *frame = m_pendingFrame.fetchAndStoreOrdered(nullptr)) {
+                    replaceImage(frame->image, frame->opaque);
+                    delete frame;
+                }
+                return;
+            }
+            update();
+        },
+        Qt::QueuedConnection);
 }
+
+QSGNode *QImageItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    // Called on the render thread while the gui thread is blocked, so the frame can be swapped in directly
+    if (Frame *frame = m_pendingFrame.fetchAndStoreOrdered(nullptr)) {
+        takeFrame(frame);
+    }
+
+    // Our own node tree is a plain QSGNode, the one of QQuickPaintedItem a geometry node
+    const bool oriented = m_paintedOrientation != QImageIOHandler::TransformationNone && !m_paintedImage.isNull() && (m_fillMode < Tile || m_fillMode == Pad);
+    if (oldNode && (oldNode->type() == QSGNode::BasicNodeType) != oriented) {
+        delete oldNode;
+        oldNode = nullptr;
+    }
+
+    if (oriented) {
+        return updateOrientedNode(static_cast<OrientedImageNode *>(oldNode));
+    }
+    return QQuickPaintedItem::updatePaintNode(oldNode, data);
+}
+
+QSGNode *QImageItem::updateOrientedNode(OrientedImageNode *node)
+{
+    // Rotated and mirrored by the scene graph: going through paint() would rasterize
+    // the image again on every update, e.g. every frame of the crossfade
+    if (width() <= 0 || height() <= 0) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new OrientedImageNode;
+        node->opacity = new QSGOpacityNode;
+        node->transform = new QSGTransformNode;
+        node->image = window()->createImageNode();
+        node->image->setOwnsTexture(true);
+        node->transform->appendChildNode(node->image);
+        node->opacity->appendChildNode(node->transform);
+        node->appendChildNode(node->opacity);
+    }
+
+    const bool showPlaceholder = !m_placeholderImage.isNull() && m_crossfade < 1;
+    if (showPlaceholder) {
+        if (!node->placeholder) {
+            node->placeholder = window()->createImageNode();
+            node->placeholder->setOwnsTexture(true);
+            // Bilinear upscaling of the tiny placeholder blurs it
+            node->placeholder->setFiltering(QSGTexture::Linear);
+            node->prependChildNode(node->placeholder);
+        }
+        if (node->placeholderKey != m_placeholderImage.cacheKey()) {
+            node->placeholder->setTexture(window()->createTextureFromImage(m_placeholderImage));
+            node->placeholderKey = m_placeholderImage.cacheKey();
+        }
+        setVisibleRect(node->placeholder, placeholderRect(), m_placeholderImage.size(), boundingRect());
+    } else if (node->placeholder) {
+        delete node->placeholder;
+        node->placeholder = nullptr;
+        node->placeholderKey = 0;
+    }
+    node->opacity->setOpacity(showPlaceholder ? m_crossfade : 1);
+
+    if (node->imageKey != m_paintedImage.cacheKey()) {
+        const bool opaque = m_imageOpaque && m_paintedImage.cacheKey() == m_image.cacheKey();
+        node->image->setTexture(window()->createTextureFromImage(m_paintedImage, opaque ? QQuickWindow::TextureIsOpaque : QQuickWindow::CreateTextureOptions()));
+        node->imageKey = m_paintedImage.cacheKey();
+    }
+    // While resizing, trade quality for speed, nobody can tell the difference at that point
+    node->image->setFiltering(smooth() && !m_adaptiveQuality->isResizing() ? QSGTexture::Linear : QSGTexture::Nearest);
+
+    // The image is drawn in its own pixels, cropped to the item like the texture of paint() would
+    const QTransform transform = imageTransform();
+    node->transform->setMatrix(QMatrix4x4(transform));
+    setVisibleRect(node->image, QRectF(m_paintedImage.rect()), m_paintedImage.size(), transform.inverted().mapRect(boundingRect()));
+
+    m_adaptiveQuality->setFramePainted(!m_paintedRect.isEmpty());
+    return node;
+}
+
+void QImageItem::takeFrame(Frame *frame)
+{
+    const QImage oldImage = m_image;
+    const bool oldOpaque = m_imageOpaque;
+
+    m_image = std::move(frame->image);
+    m_imageOpaque = frame->opaque;
+    delete frame;
+    m_paintedImage = m_image;
+    m_colorsValid = false;
+    m_paintedOrientation = m_orientation;
+    m_uploadPending = false;
+
+    const bool sizeChanged = m_image.size() != oldImage.size() || m_image.devicePixelRatio() != oldImage.devicePixelRatio();
+    if (sizeChanged && !m_image.isNull()) {
+        m_paintedRect = calculatePaintedRect().toRect();
+    }
+
+    if (!sizeChanged && oldOpaque == m_imageOpaque && oldImage.isNull() == m_image.isNull() && !m_colorsUsed) {
+        return;
+    }
+
+    // Property notifications and QQuickPaintedItem setters belong to the gui thread
+    QMetaObject::invokeMethod(
+        this,
+        [this, sizeChanged, nullChanged = oldImage.isNull() != m_image.isNull()]() {
+            updateOpaquePainting();
+            // Picks up whichever frame is current by then, older results are discarded
+            if (m_colorsUsed) {
+                extractColors();
+            }
+            if (sizeChanged) {
+                Q_EMIT nativeWidthChanged();
+                Q_EMIT nativeHeightChanged();
+                Q_EMIT paintedWidthChanged();
+                Q_EMIT paintedHeightChanged();
+            }
+            if (nullChanged) {
+                Q_EMIT nullChanged();
+            }
+        },
+        Qt::QueuedConnection);
+}
+
 void QImageItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
 {
     QQuickPaintedItem::geometryChange(newGeometry, oldGeometry);
+    m_adaptiveQuality->sizeChanged(newGeometry.size(), oldGeometry.size());
+    if (m_pyramid) {
+        m_pyramid->setSize(newGeometry.size());
+    }
     updatePaintedRect();
+
+    // Variants chosen by width are chosen again once another one fits the new width better
+    if (!m_sources.isEmpty() && !m_sourcePending && m_sourceDpr > 0 && newGeometry.width() != oldGeometry.width()
+        && selectSource(m_sources, m_sourceDpr, sourceSelectionWidth()).first != m_selectedSource) {
+        loadSource();
+    }
+}
+
+void QImageItem::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    // The pyramid needs to know about all clipping ancestors, e.g. when we are moved into a Flickable
+    if (change == ItemParentHasChanged && m_pyramid) {
+        m_pyramid->updateViewportConnections();
+    }
+
+    // A pending upload belongs to the scheduler of the previous window
+    if (change == ItemSceneChange && m_uploadPending) {
+        m_uploadPending = false;
+        updatePaintedImage();
+    }
+
+    // Only decode what is shown, and stop decoding what isn't anymore
+    if (change == ItemVisibleHasChanged && !value.boolValue && m_decodeTicket) {
+        cancelDecode();
+        m_sourcePending = true;
+    } else if ((change == ItemVisibleHasChanged || change == ItemSceneChange) && m_sourcePending) {
+        loadSource();
+    } else if (change == ItemDevicePixelRatioHasChanged || change == ItemSceneChange) {
+        // Moved to a screen with a different scale, pick the variant matching it
+        const bool dependsOnDpr = !m_sources.isEmpty() || (!m_source.isEmpty() && ImageDecodeScheduler::isScaledSize(m_sourceSize));
+        if (dependsOnDpr && window() && window()->effectiveDevicePixelRatio() != m_sourceDpr) {
+            loadSource();
+        }
+    }
+
+    if (change == ItemDevicePixelRatioHasChanged || change == ItemSceneChange) {
+        updatePrescaledImage();
+    }
+
+    QQuickPaintedItem::itemChange(change, value);
 }
 
 #include "moc_qimageitem.cpp"
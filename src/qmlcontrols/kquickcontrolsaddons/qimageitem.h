@@ -8,8 +8,21 @@
 #ifndef QIMAGEITEM_H
 #define QIMAGEITEM_H
 
+#include <QAtomicInteger>
+#include <QAtomicPointer>
+#include <QColor>
 #include <QImage>
+#include <QImageIOHandler>
 #include <QQuickPaintedItem>
+#include <QUrl>
+#include <QVariantList>
+
+#include <utility>
+
+class ImagePyramidItem;
+class OrientedImageNode;
+class AdaptiveQuality;
+class QVariantAnimation;
 
 class QImageItem : public QQuickPaintedItem
 {
@@ -24,6 +37,152 @@ class QImageItem : public QQuickPaintedItem
     Q_PROPERTY(FillMode fillMode READ fillMode WRITE setFillMode NOTIFY fillModeChanged)
     Q_PROPERTY(bool null READ isNull NOTIFY nullChanged)
 
+    /**
+     * If true, the image is rendered as a pyramid of tiles at multiple resolutions:
+     * only the tiles intersecting the visible part of the item (inside the window
+     * and any clipping ancestor such as a Flickable) are created and uploaded,
+     * and the ones scrolled out of view are evicted least recently used first.
+     *
+     * Use this for images larger than the maximum texture size, or for very large
+     * items showing a zoomed image inside a Flickable. The tile textures stay within
+     * a fixed budget however big the image or the item are, the image itself and its
+     * downscaled levels, about a third more, stay in memory.
+     *
+     * The Tile, TileVertically and TileHorizontally fill modes are always rendered untiled.
+     * Defaults to false.
+     * @since 6.0
+     */
+    Q_PROPERTY(bool tiled READ isTiled WRITE setTiled NOTIFY tiledChanged)
+
+    /**
+     * If true, a new image is not painted right away: the texture uploads of all the
+     * image items of a window are spread over several frames, the items with the
+     * largest visible area first, and the previous image is shown until it is this
+     * item's turn. Use this for delegates of views that scroll in many images at once.
+     *
+     * Tiled items upload their tiles on demand and are never deferred.
+     * Defaults to false.
+     * @since 6.0
+     */
+    Q_PROPERTY(bool deferredUpload READ deferredUpload WRITE setDeferredUpload NOTIFY deferredUploadChanged)
+
+    /**
+     * If true, while the item is being resized, e.g. by an animation, the image is
+     * drawn with fast sampling whatever smooth says. Once the size didn't change
+     * for a short while it is drawn again with the smooth path, from a copy scaled
+     * down with area averaging when it is shrunk by more than half, which is both
+     * sharper and cheaper to draw than filtering the full image every time.
+     *
+     * Defaults to false.
+     * @since 6.0
+     */
+    Q_PROPERTY(bool adaptiveQuality READ adaptiveQuality WRITE setAdaptiveQuality NOTIFY adaptiveQualityChanged)
+
+    /**
+     * A local file or resource to load the image from, as an alternative to setting it directly.
+     *
+     * The image is decoded on a worker thread once the item is visible, items showing the
+     * same source at the same time share a single decode. Hiding or destroying the item
+     * before the decode finished cancels it.
+     * @since 6.0
+     */
+    Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+
+    /**
+     * If set, the image loaded from source is scaled down while decoding to fit this size,
+     * in device independent pixels. A width or height of 0 follows the aspect ratio of the
+     * image. Defaults to the natural size of the image.
+     * @since 6.0
+     */
+    Q_PROPERTY(QSize sourceSize READ sourceSize WRITE setSourceSize NOTIFY sourceSizeChanged)
+
+    /**
+     * Variants of the same image for different device pixel ratios, takes precedence over source.
+     *
+     * Each entry is an object with a "source" url and the "scale" the variant was made for:
+     * @code
+     * sources: [
+     *     { source: "avatar.png", scale: 1 },
+     *     { source: "avatar@2x.png", scale: 2 },
+     * ]
+     * @endcode
+     *
+     * Only one variant is decoded: the one with the smallest scale not below the device
+     * pixel ratio of the window, or the largest one if there is none. The selection is
+     * redone when the item moves to a screen with a different device pixel ratio.
+     *
+     * If every entry also gives the "width" of the variant in pixels, the narrowest variant
+     * at least as wide as sourceSize, or as the item when sourceSize has no width, times the
+     * device pixel ratio is decoded instead, or the widest one if none is. The selection is
+     * then also redone when the width of the item changes.
+     * @code
+     * sources: [
+     *     { source: "photo-640.jpg", width: 640 },
+     *     { source: "photo-1920.jpg", width: 1920 },
+     * ]
+     * @endcode
+     * @since 6.0
+     */
+    Q_PROPERTY(QVariantList sources READ sources WRITE setSources NOTIFY sourcesChanged)
+
+    /**
+     * The orientation of the image, as the values of the Exif orientation tag: 1 for
+     * an upright image, up to 8. The image is rotated and mirrored by the transform of
+     * its scene graph node, its pixels are never transformed in memory; nativeWidth,
+     * nativeHeight and the fill modes use the size of the oriented image. The tiling fill
+     * modes still orient the image while painting it.
+     *
+     * Defaults to 1.
+     * @since 6.0
+     */
+    Q_PROPERTY(int orientation READ orientation WRITE setOrientation NOTIFY orientationChanged)
+
+    /**
+     * If true, images loaded from source or sources set orientation from their
+     * metadata, such as the Exif orientation of photos. Defaults to true.
+     * @since 6.0
+     */
+    Q_PROPERTY(bool autoTransform READ autoTransform WRITE setAutoTransform NOTIFY autoTransformChanged)
+
+    /**
+     * A BlurHash (https://blurha.sh) of the image, shown until the image is
+     * available, e.g. while it is decoded from source. The image then fades in
+     * over it.
+     *
+     * The placeholder covers the area the fill mode gives the image. Until the
+     * image is there, its aspect ratio is taken from sourceSize if both of its
+     * dimensions are set, otherwise the placeholder covers the whole item.
+     *
+     * A BlurHash takes 20 to 30 characters and decodes almost instantly, so it
+     * can be stored next to the image url in a model.
+     * @since 6.0
+     */
+    Q_PROPERTY(QString placeholder READ placeholder WRITE setPlaceholder NOTIFY placeholderChanged)
+
+    /**
+     * The most common color of the image, e.g. to derive an accent color from it.
+     *
+     * The colors are computed on a worker thread from a downscaled copy of the image,
+     * the first time one of dominantColor, averageColor or palette is read and then
+     * again whenever the image changes. They are invalid until the first result is in.
+     * @since 6.0
+     */
+    Q_PROPERTY(QColor dominantColor READ dominantColor NOTIFY colorsChanged)
+
+    /**
+     * The average color of the image, weighted by opacity.
+     * @see dominantColor
+     * @since 6.0
+     */
+    Q_PROPERTY(QColor averageColor READ averageColor NOTIFY colorsChanged)
+
+    /**
+     * Up to five main colors of the image, most common first.
+     * @see dominantColor
+     * @since 6.0
+     */
+    Q_PROPERTY(QVariantList palette READ palette NOTIFY colorsChanged)
+
 public:
     enum FillMode {
         Stretch, // the image is scaled to fit
@@ -56,6 +215,59 @@ public:
 
     bool isNull() const;
 
+    bool isTiled() const;
+    void setTiled(bool tiled);
+
+    bool deferredUpload() const;
+    void setDeferredUpload(bool deferred);
+
+    bool adaptiveQuality() const;
+    void setAdaptiveQuality(bool adaptive);
+
+    /**
+     * Shows @p frame as the new image. Unlike setImage(), this can be called from any thread.
+     *
+     * Meant for producers such as video decoders or cameras running on worker threads:
+     * the frame is handed over through a single slot mailbox which the scene graph picks
+     * up when it renders the next frame, without queuing the image through the gui thread.
+     * A frame not rendered yet when the next one arrives is dropped, so producers faster
+     * than the display never build up latency.
+     *
+     * imageChanged() is not emitted for every frame, the notifications of the size related
+     * properties are. The item must outlive calls to this function.
+     * @since 6.0
+     */
+    void presentFrame(const QImage &frame);
+
+    /**
+     * The entry of @p sources to decode for a screen with device pixel ratio @p dpr, when
+     * the image is shown @p width device independent pixels wide, and the scale to decode
+     * it at. See the sources property.
+     */
+    static std::pair<QUrl, qreal> selectSource(const QVariantList &sources, qreal dpr, qreal width);
+
+    QUrl source() const;
+    void setSource(const QUrl &source);
+
+    QSize sourceSize() const;
+    void setSourceSize(const QSize &size);
+
+    QVariantList sources() const;
+    void setSources(const QVariantList &sources);
+
+    int orientation() const;
+    void setOrientation(int orientation);
+
+    bool autoTransform() const;
+    void setAutoTransform(bool autoTransform);
+
+    QString placeholder() const;
+    void setPlaceholder(const QString &placeholder);
+
+    QColor dominantColor() const;
+    QColor averageColor() const;
+    QVariantList palette() const;
+
 Q_SIGNALS:
     void nativeWidthChanged();
     void nativeHeightChanged();
@@ -64,14 +276,87 @@ Q_SIGNALS:
     void nullChanged();
     void paintedWidthChanged();
     void paintedHeightChanged();
+    void tiledChanged();
+    void deferredUploadChanged();
+    void adaptiveQualityChanged();
+    void sourceChanged();
+    void sourceSizeChanged();
+    void sourcesChanged();
+    void orientationChanged();
+    void autoTransformChanged();
+    void placeholderChanged();
+    void colorsChanged();
 
 protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
 
 private:
+    // A frame handed over by presentFrame(), scanned for opacity by the producer
+    struct Frame {
+        QImage image;
+        bool opaque;
+    };
+
+    void setTransformation(QImageIOHandler::Transformations transformation);
+    QSize orientedSize() const;
+    QTransform imageTransform() const;
+    QRectF calculatePaintedRect() const;
+    QRectF placeholderRect() const;
+    QSGNode *updateOrientedNode(OrientedImageNode *node);
+    void replaceImage(const QImage &image, bool opaque);
+    void takeFrame(Frame *frame);
+    void extractColors();
+    void updatePyramid();
+    void scheduleUpload();
+    void updatePaintedImage();
+    void updateOpaquePainting();
+    void updatePrescaledImage();
+    void updateSource();
+    void loadSource();
+    qreal sourceSelectionWidth() const;
+    void cancelDecode();
+
     QImage m_image;
+    bool m_imageOpaque = false;
+    // What paint() draws, lags behind m_image while a deferred upload is pending
+    QImage m_paintedImage;
     FillMode m_fillMode;
     QRect m_paintedRect;
+    bool m_tiled = false;
+    ImagePyramidItem *m_pyramid = nullptr;
+    bool m_deferredUpload = false;
+    bool m_uploadPending = false;
+    AdaptiveQuality *m_adaptiveQuality;
+    // Written by presentFrame() on any thread, taken by the render thread
+    QAtomicPointer<Frame> m_pendingFrame;
+    QAtomicInt m_frameUpdateQueued;
+    QUrl m_source;
+    QSize m_sourceSize;
+    QVariantList m_sources;
+    // The unresolved url of the entry of m_sources being shown
+    QUrl m_selectedSource;
+    QImageIOHandler::Transformations m_orientation = QImageIOHandler::TransformationNone;
+    // The orientation of m_paintedImage
+    QImageIOHandler::Transformations m_paintedOrientation = QImageIOHandler::TransformationNone;
+    bool m_autoTransform = true;
+    // Whether m_orientation was read from the metadata of the source
+    bool m_orientationFromSource = false;
+    QString m_placeholder;
+    QImage m_placeholderImage;
+    QVariantAnimation *m_crossfadeAnimation = nullptr;
+    qreal m_crossfade = 1;
+    QColor m_averageColor;
+    QList<QColor> m_palette;
+    // Whether the colors were asked for, and whether they are up to date with m_image
+    bool m_colorsUsed = false;
+    bool m_colorsValid = false;
+    quint64 m_colorsGeneration = 0;
+    qreal m_sourceDpr = 0;
+    quint64 m_decodeTicket = 0;
+    // The source still needs to be loaded once the item is visible
+    bool m_sourcePending = false;
 
 private Q_SLOTS:
     void updatePaintedRect();
@@ -6,26 +6,39 @@
 */
 
 #include "qpixmapitem.h"
+#include "adaptivequality.h"
+#include "imageanalysis.h"
+#include "imagedecodescheduler.h"
+#include "imageuploadscheduler.h"
 
 #include <QPainter>
+#include <QQuickWindow>
 
 QPixmapItem::QPixmapItem(QQuickItem *parent)
     : QQuickPaintedItem(parent)
     , m_fillMode(QPixmapItem::Stretch)
+    , m_adaptiveQuality(new AdaptiveQuality(this))
 {
     setFlag(ItemHasContents, true);
+    connect(m_adaptiveQuality, &AdaptiveQuality::settled, this, &QPixmapItem::updatePrescaledPixmap);
+    connect(m_adaptiveQuality, &AdaptiveQuality::changed, this, [this]() {
+        update();
+    });
 }
 
 QPixmapItem::~QPixmapItem()
 {
+    cancelDecode();
 }
 
 void QPixmapItem::setPixmap(const QPixmap &pixmap)
 {
     bool oldPixmapNull = m_pixmap.isNull();
     m_pixmap = pixmap;
-    updatePaintedRect();
-    update();
+    // Scanned once here rather than on every paint, reading back the pixels only if needed
+    m_pixmapOpaque = !m_pixmap.isNull() && (!m_pixmap.hasAlphaChannel() || ImageAnalysis::isOpaque(m_pixmap.toImage()));
+    // Updates the painted rect along with the painted pixmap, right away or once it's our turn
+    scheduleUpload();
     Q_EMIT nativeWidthChanged();
     Q_EMIT nativeHeightChanged();
     Q_EMIT pixmapChanged();
@@ -66,35 +79,192 @@ void QPixmapItem::setFillMode(QPixmapItem::FillMode mode)
     }
 
     m_fillMode = mode;
+    updateOpaquePainting();
     updatePaintedRect();
     update();
     Q_EMIT fillModeChanged();
 }
 
+bool QPixmapItem::deferredUpload() const
+{
+    return m_deferredUpload;
+}
+
+void QPixmapItem::setDeferredUpload(bool deferred)
+{
+    if (deferred == m_deferredUpload) {
+        return;
+    }
+
+    m_deferredUpload = deferred;
+    if (!m_deferredUpload && m_uploadPending) {
+        scheduleUpload();
+    }
+    Q_EMIT deferredUploadChanged();
+}
+
+QUrl QPixmapItem::source() const
+{
+    return m_source;
+}
+
+void QPixmapItem::setSource(const QUrl &source)
+{
+    if (source == m_source) {
+        return;
+    }
+
+    m_source = source;
+    if (m_source.isEmpty()) {
+        cancelDecode();
+        m_sourcePending = false;
+        resetPixmap();
+    } else {
+        loadSource();
+    }
+    Q_EMIT sourceChanged();
+}
+
+QSize QPixmapItem::sourceSize() const
+{
+    return m_sourceSize;
+}
+
+void QPixmapItem::setSourceSize(const QSize &size)
+{
+    if (size == m_sourceSize) {
+        return;
+    }
+
+    m_sourceSize = size;
+    if (!m_source.isEmpty()) {
+        loadSource();
+    }
+    Q_EMIT sourceSizeChanged();
+}
+
+void QPixmapItem::loadSource()
+{
+    cancelDecode();
+
+    if (!isVisible() || !window()) {
+        m_sourcePending = true;
+        return;
+    }
+
+    m_sourcePending = false;
+    // Without a size to fit the pixmap is used at its natural size
+    const qreal dpr = ImageDecodeScheduler::isScaledSize(m_sourceSize) ? window()->effectiveDevicePixelRatio() : 1;
+    m_decodeTicket = ImageDecodeScheduler::instance()->request(m_source, m_sourceSize, dpr, ImageDecodeScheduler::ApplyTransformation, this, [this](const QImage &image, QImageIOHandler::Transformations) {
+        m_decodeTicket = 0;
+        setPixmap(QPixmap::fromImage(image));
+    });
+}
+
+void QPixmapItem::cancelDecode()
+{
+    if (m_decodeTicket) {
+        ImageDecodeScheduler::instance()->cancel(m_decodeTicket);
+        m_decodeTicket = 0;
+    }
+}
+
+bool QPixmapItem::adaptiveQuality() const
+{
+    return m_adaptiveQuality->isEnabled();
+}
+
+void QPixmapItem::setAdaptiveQuality(bool adaptive)
+{
+    if (adaptive == m_adaptiveQuality->isEnabled()) {
+        return;
+    }
+
+    m_adaptiveQuality->setEnabled(adaptive);
+    updatePrescaledPixmap();
+    update();
+    Q_EMIT adaptiveQualityChanged();
+}
+
+void QPixmapItem::updatePrescaledPixmap()
+{
+    // Only untiled pixmaps. Done here rather than in paint(), which runs on the render thread for every frame.
+    if (!m_adaptiveQuality->isEnabled() || m_fillMode >= Tile) {
+        m_adaptiveQuality->prescale(QImage(), 0, QSize());
+        return;
+    }
+
+    // Pixmaps are raster images nowadays, converting them only shares the pixels
+    const qreal scale = window() ? window()->effectiveDevicePixelRatio() : 1;
+    m_adaptiveQuality->prescale(m_paintedPixmap.toImage(), m_paintedPixmap.cacheKey(), (QSizeF(m_paintedRect.size()) * scale).toSize());
+}
+
+void QPixmapItem::scheduleUpload()
+{
+    if (!m_deferredUpload || !window()) {
+        if (m_uploadPending && window()) {
+            ImageUploadScheduler::instance(window())->cancel(this);
+        }
+        m_uploadPending = false;
+        updatePaintedPixmap();
+        return;
+    }
+
+    m_uploadPending = true;
+    ImageUploadScheduler::instance(window())->schedule(this, [this] {
+        m_uploadPending = false;
+        updatePaintedPixmap();
+    });
+}
+
+void QPixmapItem::updatePaintedPixmap()
+{
+    m_paintedPixmap = m_pixmap;
+    updateOpaquePainting();
+    updatePaintedRect();
+    update();
+}
+
+void QPixmapItem::updateOpaquePainting()
+{
+    // Lets the renderer draw the item in its opaque batch, without blending and
+    // hiding what is below, but only if the pixmap covers all of the item
+    const bool coversItem = m_fillMode != PreserveAspectFit;
+    setOpaquePainting(m_pixmapOpaque && coversItem && m_paintedPixmap.cacheKey() == m_pixmap.cacheKey());
+}
+
 void QPixmapItem::paint(QPainter *painter)
 {
-    if (m_pixmap.isNull()) {
+    if (m_paintedPixmap.isNull()) {
         return;
     }
     painter->save();
-    painter->setRenderHint(QPainter::Antialiasing, smooth());
-    painter->setRenderHint(QPainter::SmoothPixmapTransform, smooth());
+    // While resizing, trade quality for speed, nobody can tell the difference at that point
+    const bool smoothPainting = smooth() && !m_adaptiveQuality->isResizing();
+    painter->setRenderHint(QPainter::Antialiasing, smoothPainting);
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, smoothPainting);
 
     if (m_fillMode == TileVertically) {
-        painter->scale(width() / (qreal)m_pixmap.width(), 1);
+        painter->scale(width() / (qreal)m_paintedPixmap.width(), 1);
     }
 
     if (m_fillMode == TileHorizontally) {
-        painter->scale(1, height() / (qreal)m_pixmap.height());
+        painter->scale(1, height() / (qreal)m_paintedPixmap.height());
     }
 
     if (m_fillMode >= Tile) {
-        painter->drawTiledPixmap(m_paintedRect, m_pixmap);
+        painter->drawTiledPixmap(m_paintedRect, m_paintedPixmap);
     } else {
-        painter->drawPixmap(m_paintedRect, m_pixmap, m_pixmap.rect());
+        const QImage prescaled = smoothPainting ? m_adaptiveQuality->prescaled(m_paintedPixmap.cacheKey()) : QImage();
+        if (prescaled.isNull()) {
+            painter->drawPixmap(m_paintedRect, m_paintedPixmap, m_paintedPixmap.rect());
+        } else {
+            painter->drawImage(m_paintedRect, prescaled, prescaled.rect());
+        }
     }
 
     painter->restore();
+    m_adaptiveQuality->setFramePainted(!m_paintedRect.isEmpty());
 }
 
 bool QPixmapItem::isNull() const
@@ -104,7 +274,7 @@ bool QPixmapItem::isNull() const
 
 int QPixmapItem::paintedWidth() const
 {
-    if (m_pixmap.isNull()) {
+    if (m_paintedPixmap.isNull()) {
         return 0;
     }
 
@@ -113,7 +283,7 @@ int QPixmapItem::paintedWidth() const
 
 int QPixmapItem::paintedHeight() const
 {
-    if (m_pixmap.isNull()) {
+    if (m_paintedPixmap.isNull()) {
         return 0;
     }
 
@@ -122,7 +292,8 @@ int QPixmapItem::paintedHeight() const
 
 void QPixmapItem::updatePaintedRect()
 {
-    if (m_pixmap.isNull()) {
+    // Of what is painted, which lags behind m_pixmap while a deferred upload is pending
+    if (m_paintedPixmap.isNull()) {
         return;
     }
 
@@ -132,7 +303,7 @@ void QPixmapItem::updatePaintedRect()
 
     switch (m_fillMode) {
     case PreserveAspectFit: {
-        QSizeF scaled = m_pixmap.size();
+        QSizeF scaled = m_paintedPixmap.size();
 
         scaled.scale(boundingRect().size(), Qt::KeepAspectRatio);
         destRect = QRectF(QPoint(0, 0), scaled);
@@ -141,7 +312,7 @@ void QPixmapItem::updatePaintedRect()
         break;
     }
     case PreserveAspectCrop: {
-        QSizeF scaled = m_pixmap.size();
+        QSizeF scaled = m_paintedPixmap.size();
 
         scaled.scale(boundingRect().size(), Qt::KeepAspectRatioByExpanding);
         destRect = QRectF(QPoint(0, 0), scaled);
@@ -150,12 +321,12 @@ void QPixmapItem::updatePaintedRect()
     }
     case TileVertically: {
         destRect = boundingRect().toRect();
-        destRect.setWidth(destRect.width() / (width() / (qreal)m_pixmap.width()));
+        destRect.setWidth(destRect.width() / (width() / (qreal)m_paintedPixmap.width()));
         break;
     }
     case TileHorizontally: {
         destRect = boundingRect().toRect();
-        destRect.setHeight(destRect.height() / (height() / (qreal)m_pixmap.height()));
+        destRect.setHeight(destRect.height() / (height() / (qreal)m_paintedPixmap.height()));
         break;
     }
     case Stretch:
@@ -169,12 +340,38 @@ void QPixmapItem::updatePaintedRect()
         Q_EMIT paintedHeightChanged();
         Q_EMIT paintedWidthChanged();
     }
+
+    updatePrescaledPixmap();
 }
 
 void QPixmapItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
 {
     QQuickPaintedItem::geometryChange(newGeometry, oldGeometry);
+    m_adaptiveQuality->sizeChanged(newGeometry.size(), oldGeometry.size());
     updatePaintedRect();
 }
 
+void QPixmapItem::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    // A pending upload belongs to the scheduler of the previous window
+    if (change == ItemSceneChange && m_uploadPending) {
+        m_uploadPending = false;
+        updatePaintedPixmap();
+    }
+
+    // Only decode what is shown, and stop decoding what isn't anymore
+    if (change == ItemVisibleHasChanged && !value.boolValue && m_decodeTicket) {
+        cancelDecode();
+        m_sourcePending = true;
+    } else if ((change == ItemVisibleHasChanged || change == ItemSceneChange) && m_sourcePending) {
+        loadSource();
+    }
+
+    if (change == ItemDevicePixelRatioHasChanged || change == ItemSceneChange) {
+        updatePrescaledPixmap();
+    }
+
+    QQuickPaintedItem::itemChange(change, value);
+}
+
 #include "moc_qpixmapitem.cpp"
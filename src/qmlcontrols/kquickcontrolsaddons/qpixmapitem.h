@@ -10,6 +10,9 @@
 
 #include <QPixmap>
 #include <QQuickPaintedItem>
+#include <QUrl>
+
+class AdaptiveQuality;
 
 class QPixmapItem : public QQuickPaintedItem
 {
@@ -24,6 +27,44 @@ class QPixmapItem : public QQuickPaintedItem
     Q_PROPERTY(FillMode fillMode READ fillMode WRITE setFillMode NOTIFY fillModeChanged)
     Q_PROPERTY(bool null READ isNull NOTIFY nullChanged)
 
+    /**
+     * If true, a new pixmap is not painted right away: the texture uploads of all the
+     * image items of a window are spread over several frames, the items with the
+     * largest visible area first, and the previous pixmap is shown until it is this
+     * item's turn. Use this for delegates of views that scroll in many images at once.
+     *
+     * Defaults to false.
+     * @since 6.0
+     */
+    Q_PROPERTY(bool deferredUpload READ deferredUpload WRITE setDeferredUpload NOTIFY deferredUploadChanged)
+
+    /**
+     * If true, the pixmap is drawn with fast sampling while the item is being resized,
+     * and from a smoothly downscaled copy once the size settled, see QImageItem::adaptiveQuality.
+     *
+     * Defaults to false.
+     * @since 6.0
+     */
+    Q_PROPERTY(bool adaptiveQuality READ adaptiveQuality WRITE setAdaptiveQuality NOTIFY adaptiveQualityChanged)
+
+    /**
+     * A local file or resource to load the pixmap from, as an alternative to setting it directly.
+     *
+     * The pixmap is decoded on a worker thread once the item is visible, items showing the
+     * same source at the same time share a single decode. Hiding or destroying the item
+     * before the decode finished cancels it.
+     * @since 6.0
+     */
+    Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+
+    /**
+     * If set, the pixmap loaded from source is scaled down while decoding to fit this size,
+     * in device independent pixels. A width or height of 0 follows the aspect ratio of the
+     * pixmap. Defaults to the natural size of the pixmap.
+     * @since 6.0
+     */
+    Q_PROPERTY(QSize sourceSize READ sourceSize WRITE setSourceSize NOTIFY sourceSizeChanged)
+
 public:
     enum FillMode {
         Stretch, // the image is scaled to fit
@@ -55,6 +96,18 @@ public:
 
     bool isNull() const;
 
+    bool deferredUpload() const;
+    void setDeferredUpload(bool deferred);
+
+    bool adaptiveQuality() const;
+    void setAdaptiveQuality(bool adaptive);
+
+    QUrl source() const;
+    void setSource(const QUrl &source);
+
+    QSize sourceSize() const;
+    void setSourceSize(const QSize &size);
+
 Q_SIGNALS:
     void nativeWidthChanged();
     void nativeHeightChanged();
@@ -63,14 +116,37 @@ Q_SIGNALS:
     void nullChanged();
     void paintedWidthChanged();
     void paintedHeightChanged();
+    void deferredUploadChanged();
+    void adaptiveQualityChanged();
+    void sourceChanged();
+    void sourceSizeChanged();
 
 protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
 
 private:
+    void scheduleUpload();
+    void updatePaintedPixmap();
+    void updateOpaquePainting();
+    void updatePrescaledPixmap();
+    void loadSource();
+    void cancelDecode();
+
     QPixmap m_pixmap;
+    bool m_pixmapOpaque = false;
+    // What paint() draws, lags behind m_pixmap while a deferred upload is pending
+    QPixmap m_paintedPixmap;
     FillMode m_fillMode;
     QRect m_paintedRect;
+    bool m_deferredUpload = false;
+    bool m_uploadPending = false;
+    AdaptiveQuality *m_adaptiveQuality;
+    QUrl m_source;
+    QSize m_sourceSize;
+    quint64 m_decodeTicket = 0;
+    // The source still needs to be loaded once the item is visible
+    bool m_sourcePending = false;
 
 private Q_SLOTS:
     void updatePaintedRect();
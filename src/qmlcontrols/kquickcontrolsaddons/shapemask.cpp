@@ -0,0 +1,203 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "shapemask.h"
+
+#include <QQuickItem>
+
+#include <algorithm>
+#include <cmath>
+
+ShapeMask::ShapeMask(QObject *parent)
+    : QObject(parent)
+{
+}
+
+ShapeMask::~ShapeMask() = default;
+
+ShapeMask::Shape ShapeMask::shape() const
+{
+    return m_shape;
+}
+
+void ShapeMask::setShape(Shape shape)
+{
+    if (shape == m_shape) {
+        return;
+    }
+
+    m_shape = shape;
+    Q_EMIT shapeChanged();
+}
+
+QRectF ShapeMask::rect() const
+{
+    return m_rect;
+}
+
+void ShapeMask::setRect(const QRectF &rect)
+{
+    if (rect == m_rect) {
+        return;
+    }
+
+    m_rect = rect;
+    Q_EMIT rectChanged();
+}
+
+void ShapeMask::resetRect()
+{
+    setRect(QRectF());
+}
+
+qreal ShapeMask::radius() const
+{
+    return m_radius;
+}
+
+void ShapeMask::setRadius(qreal radius)
+{
+    radius = std::max<qreal>(radius, 0);
+    if (qFuzzyCompare(radius, m_radius)) {
+        return;
+    }
+
+    m_radius = radius;
+    Q_EMIT radiusChanged();
+}
+
+QList<QPointF> ShapeMask::points() const
+{
+    return m_polygon;
+}
+
+void ShapeMask::setPoints(const QList<QPointF> &points)
+{
+    if (points == m_polygon) {
+        return;
+    }
+
+    m_polygon = QPolygonF(points);
+    m_polygonBounds = m_polygon.boundingRect();
+    Q_EMIT pointsChanged();
+}
+
+Qt::FillRule ShapeMask::fillRule() const
+{
+    return m_fillRule;
+}
+
+void ShapeMask::setFillRule(Qt::FillRule rule)
+{
+    if (rule == m_fillRule) {
+        return;
+    }
+
+    m_fillRule = rule;
+    Q_EMIT fillRuleChanged();
+}
+
+QImage ShapeMask::image() const
+{
+    return m_image;
+}
+
+void ShapeMask::setImage(const QImage &image)
+{
+    if (image.cacheKey() == m_image.cacheKey()) {
+        return;
+    }
+
+    m_image = image;
+    updateBitmap();
+    Q_EMIT imageChanged();
+}
+
+qreal ShapeMask::alphaThreshold() const
+{
+    return m_alphaThreshold;
+}
+
+void ShapeMask::setAlphaThreshold(qreal threshold)
+{
+    threshold = std::clamp<qreal>(threshold, 0, 1);
+    if (qFuzzyCompare(threshold, m_alphaThreshold)) {
+        return;
+    }
+
+    m_alphaThreshold = threshold;
+    updateBitmap();
+    Q_EMIT alphaThresholdChanged();
+}
+
+QRectF ShapeMask::effectiveRect() const
+{
+    if (m_rect.isValid()) {
+        return m_rect;
+    }
+
+    // Read at every hit test, so the mask follows the size of the item without connections
+    if (auto item = qobject_cast<QQuickItem *>(parent())) {
+        return item->boundingRect();
+    }
+    return QRectF();
+}
+
+void ShapeMask::updateBitmap()
+{
+    m_bitmap.clear();
+    if (m_image.isNull()) {
+        return;
+    }
+
+    // Hit tests then only cost a lookup, whatever the format of the image
+    const QImage image = m_image.convertToFormat(QImage::Format_ARGB32);
+    const int threshold = std::max(1, qRound(m_alphaThreshold * 255));
+    m_bitmap.resize(image.width() * image.height());
+    for (int y = 0; y < image.height(); ++y) {
+        const auto *line = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            if (qAlpha(line[x]) >= threshold) {
+                m_bitmap.setBit(y * image.width() + x);
+            }
+        }
+    }
+}
+
+bool ShapeMask::contains(const QPointF &point) const
+{
+    switch (m_shape) {
+    case RoundedRectangle: {
+        const QRectF rect = effectiveRect();
+        if (!rect.contains(point)) {
+            return false;
+        }
+        const qreal radius = std::min({m_radius, rect.width() / 2, rect.height() / 2});
+        if (radius <= 0) {
+            return true;
+        }
+        // Distance from the rectangle shrunk by the radius, only non zero in the corners
+        const qreal dx = std::max({rect.left() + radius - point.x(), point.x() - (rect.right() - radius), qreal(0)});
+        const qreal dy = std::max({rect.top() + radius - point.y(), point.y() - (rect.bottom() - radius), qreal(0)});
+        return dx * dx + dy * dy <= radius * radius;
+    }
+    case Polygon:
+        return m_polygon.size() > 2 && m_polygonBounds.contains(point) && m_polygon.containsPoint(point, m_fillRule);
+    case Image: {
+        const QRectF rect = effectiveRect();
+        if (m_bitmap.isEmpty() || !rect.contains(point)) {
+            return false;
+        }
+        const int x = std::clamp(int((point.x() - rect.x()) * m_image.width() / rect.width()), 0, m_image.width() - 1);
+        const int y = std::clamp(int((point.y() - rect.y()) * m_image.height() / rect.height()), 0, m_image.height() - 1);
+        return m_bitmap.testBit(y * m_image.width() + x);
+    }
+    }
+
+    return false;
+}
+
+#include "moc_shapemask.cpp"
@@ -0,0 +1,143 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef SHAPEMASK_H
+#define SHAPEMASK_H
+
+#include <QBitArray>
+#include <QImage>
+#include <QObject>
+#include <QPolygonF>
+#include <QRectF>
+#include <qqmlregistration.h>
+
+/**
+ * A containment mask describing an irregular shape, to be assigned to the
+ * containmentMask property of an Item.
+ *
+ * Qt Quick then uses it for all hit testing of the item: presses, hover and
+ * drags outside of the shape are not delivered to it, without any QML code
+ * running. MouseEventListener and DropArea apply it to the events they see
+ * through their children as well.
+ *
+ * @code
+ * MouseEventListener {
+ *     containmentMask: ShapeMask {
+ *         shape: ShapeMask.RoundedRectangle
+ *         radius: width / 2
+ *     }
+ * }
+ * @endcode
+ *
+ * @since 6.0
+ */
+class ShapeMask : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    /**
+     * Which of the properties describe the shape, RoundedRectangle by default
+     */
+    Q_PROPERTY(Shape shape READ shape WRITE setShape NOTIFY shapeChanged)
+
+    /**
+     * The area covered by the mask for RoundedRectangle and Image, in coordinates of the item.
+     * When not set, the mask covers its parent item.
+     */
+    Q_PROPERTY(QRectF rect READ rect WRITE setRect RESET resetRect NOTIFY rectChanged)
+
+    /**
+     * The corner radius of a RoundedRectangle, at most half its shortest side
+     */
+    Q_PROPERTY(qreal radius READ radius WRITE setRadius NOTIFY radiusChanged)
+
+    /**
+     * The vertices of a Polygon, in coordinates of the item
+     */
+    Q_PROPERTY(QList<QPointF> points READ points WRITE setPoints NOTIFY pointsChanged)
+
+    /**
+     * How the inside of a self intersecting Polygon is decided, Qt.OddEvenFill by default
+     */
+    Q_PROPERTY(Qt::FillRule fillRule READ fillRule WRITE setFillRule NOTIFY fillRuleChanged)
+
+    /**
+     * The image of an Image mask, stretched over rect
+     */
+    Q_PROPERTY(QImage image READ image WRITE setImage NOTIFY imageChanged)
+
+    /**
+     * The opacity from which a pixel of an Image mask is inside the shape, 0.5 by default
+     */
+    Q_PROPERTY(qreal alphaThreshold READ alphaThreshold WRITE setAlphaThreshold NOTIFY alphaThresholdChanged)
+
+public:
+    enum Shape {
+        RoundedRectangle,
+        Polygon,
+        Image,
+    };
+    Q_ENUM(Shape)
+
+    explicit ShapeMask(QObject *parent = nullptr);
+    ~ShapeMask() override;
+
+    Shape shape() const;
+    void setShape(Shape shape);
+
+    QRectF rect() const;
+    void setRect(const QRectF &rect);
+    void resetRect();
+
+    qreal radius() const;
+    void setRadius(qreal radius);
+
+    QList<QPointF> points() const;
+    void setPoints(const QList<QPointF> &points);
+
+    Qt::FillRule fillRule() const;
+    void setFillRule(Qt::FillRule rule);
+
+    QImage image() const;
+    void setImage(const QImage &image);
+
+    qreal alphaThreshold() const;
+    void setAlphaThreshold(qreal threshold);
+
+    /**
+     * Whether @p point, in coordinates of the item, is inside the shape.
+     * Called by Qt Quick for every hit test of the item.
+     */
+    Q_INVOKABLE bool contains(const QPointF &point) const;
+
+Q_SIGNALS:
+    void shapeChanged();
+    void rectChanged();
+    void radiusChanged();
+    void pointsChanged();
+    void fillRuleChanged();
+    void imageChanged();
+    void alphaThresholdChanged();
+
+private:
+    QRectF effectiveRect() const;
+    void updateBitmap();
+
+    Shape m_shape = RoundedRectangle;
+    QRectF m_rect;
+    qreal m_radius = 0;
+    QPolygonF m_polygon;
+    // Cached to reject most points without walking the edges
+    QRectF m_polygonBounds;
+    Qt::FillRule m_fillRule = Qt::OddEvenFill;
+    QImage m_image;
+    qreal m_alphaThreshold = 0.5;
+    // One bit per pixel of m_image, set for the pixels inside the shape
+    QBitArray m_bitmap;
+};
+
+#endif
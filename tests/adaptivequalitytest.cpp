@@ -0,0 +1,183 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "adaptivequality.h"
+
+#include <QSignalSpy>
+#include <QTest>
+#include <QThreadPool>
+
+class AdaptiveQualityTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void disabled();
+    void firstLayout();
+    void resizing();
+    void prescale();
+    void smallShrink();
+    void latestRequest();
+    void disable();
+
+private:
+    QImage m_image;
+};
+
+void AdaptiveQualityTest::init()
+{
+    m_image = QImage(400, 200, QImage::Format_RGB32);
+    m_image.fill(Qt::red);
+}
+
+void AdaptiveQualityTest::disabled()
+{
+    AdaptiveQuality quality;
+    quality.setFramePainted(true);
+    quality.sizeChanged(QSizeF(50, 50), QSizeF(100, 100));
+    QVERIFY(!quality.isResizing());
+
+    QSignalSpy changed(&quality, &AdaptiveQuality::changed);
+    quality.prescale(m_image, m_image.cacheKey(), QSize(100, 50));
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    QCOMPARE(changed.count(), 0);
+    QVERIFY(quality.prescaled(m_image.cacheKey()).isNull());
+}
+
+void AdaptiveQualityTest::firstLayout()
+{
+    AdaptiveQuality quality;
+    quality.setEnabled(true);
+
+    // Nothing was drawn yet
+    quality.sizeChanged(QSizeF(50, 50), QSizeF(100, 100));
+    QVERIFY(!quality.isResizing());
+
+    // Sized for the first time
+    quality.setFramePainted(true);
+    quality.sizeChanged(QSizeF(100, 100), QSizeF(0, 0));
+    QVERIFY(!quality.isResizing());
+
+    // Moved, not resized
+    quality.sizeChanged(QSizeF(100, 100), QSizeF(100, 100));
+    QVERIFY(!quality.isResizing());
+}
+
+void AdaptiveQualityTest::resizing()
+{
+    AdaptiveQuality quality;
+    quality.setEnabled(true);
+    quality.setFramePainted(true);
+    QSignalSpy settled(&quality, &AdaptiveQuality::settled);
+    QSignalSpy changed(&quality, &AdaptiveQuality::changed);
+
+    quality.sizeChanged(QSizeF(90, 90), QSizeF(100, 100));
+    QVERIFY(quality.isResizing());
+    quality.sizeChanged(QSizeF(80, 80), QSizeF(90, 90));
+    QVERIFY(quality.isResizing());
+
+    // Once for the whole resize
+    QVERIFY(settled.wait());
+    QVERIFY(!quality.isResizing());
+    QCOMPARE(settled.count(), 1);
+    QCOMPARE(changed.count(), 1);
+
+    // Nothing is scaled during a resize
+    quality.sizeChanged(QSizeF(70, 70), QSizeF(80, 80));
+    quality.prescale(m_image, m_image.cacheKey(), QSize(100, 50));
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    QVERIFY(quality.prescaled(m_image.cacheKey()).isNull());
+}
+
+void AdaptiveQualityTest::prescale()
+{
+    AdaptiveQuality quality;
+    quality.setEnabled(true);
+    QSignalSpy changed(&quality, &AdaptiveQuality::changed);
+
+    quality.prescale(m_image, m_image.cacheKey(), QSize(100, 50));
+    // Not on the gui thread, so not right away
+    QVERIFY(quality.prescaled(m_image.cacheKey()).isNull());
+
+    QVERIFY(changed.wait());
+    const QImage prescaled = quality.prescaled(m_image.cacheKey());
+    QCOMPARE(prescaled.size(), QSize(100, 50));
+    QCOMPARE(prescaled.pixelColor(50, 25), QColor(Qt::red));
+    // Only for the image it was made from
+    QVERIFY(quality.prescaled(m_image.cacheKey() + 1).isNull());
+
+    // Asking again for the same is a no-op
+    quality.prescale(m_image, m_image.cacheKey(), QSize(100, 50));
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(quality.prescaled(m_image.cacheKey()).cacheKey(), prescaled.cacheKey());
+}
+
+void AdaptiveQualityTest::smallShrink()
+{
+    AdaptiveQuality quality;
+    quality.setEnabled(true);
+    QSignalSpy changed(&quality, &AdaptiveQuality::changed);
+
+    // Linear filtering is good enough down to half the size
+    quality.prescale(m_image, m_image.cacheKey(), QSize(200, 100));
+    quality.prescale(m_image, m_image.cacheKey(), QSize(800, 400));
+    quality.prescale(m_image, m_image.cacheKey(), QSize());
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    QCOMPARE(changed.count(), 0);
+    QVERIFY(quality.prescaled(m_image.cacheKey()).isNull());
+
+    // Shrinking a single dimension by more than half is enough
+    quality.prescale(m_image, m_image.cacheKey(), QSize(150, 100));
+    QVERIFY(changed.wait());
+    QCOMPARE(quality.prescaled(m_image.cacheKey()).size(), QSize(150, 100));
+}
+
+void AdaptiveQualityTest::latestRequest()
+{
+    AdaptiveQuality quality;
+    quality.setEnabled(true);
+    QSignalSpy changed(&quality, &AdaptiveQuality::changed);
+
+    QImage other(400, 200, QImage::Format_RGB32);
+    other.fill(Qt::blue);
+    quality.prescale(m_image, m_image.cacheKey(), QSize(100, 50));
+    quality.prescale(other, other.cacheKey(), QSize(40, 20));
+
+    // The result for the first image arrives too late and is dropped
+    QVERIFY(changed.wait());
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    QCOMPARE(changed.count(), 1);
+    QVERIFY(quality.prescaled(m_image.cacheKey()).isNull());
+    QCOMPARE(quality.prescaled(other.cacheKey()).size(), QSize(40, 20));
+}
+
+void AdaptiveQualityTest::disable()
+{
+    AdaptiveQuality quality;
+    quality.setEnabled(true);
+    quality.setFramePainted(true);
+    QSignalSpy changed(&quality, &AdaptiveQuality::changed);
+
+    quality.prescale(m_image, m_image.cacheKey(), QSize(100, 50));
+    QVERIFY(changed.wait());
+    quality.sizeChanged(QSizeF(90, 90), QSizeF(100, 100));
+    QVERIFY(quality.isResizing());
+
+    quality.setEnabled(false);
+    QVERIFY(!quality.isResizing());
+    QVERIFY(quality.prescaled(m_image.cacheKey()).isNull());
+}
+
+QTEST_GUILESS_MAIN(AdaptiveQualityTest)
+
+#include "adaptivequalitytest.moc"
@@ -0,0 +1,57 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "allocationcounter.h"
+
+#include <atomic>
+#include <cstddef>
+
+static std::atomic<quint64> s_count{0};
+
+#ifdef __GLIBC__
+// Interposes the allocator of the C library, which everything else ends up in:
+// operator new, QArrayData and the allocations of the other libraries alike.
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *p, size_t size);
+
+void *malloc(size_t size)
+{
+    s_count.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    s_count.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, size_t size)
+{
+    s_count.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+}
+#endif
+
+namespace AllocationCounter
+{
+bool isAvailable()
+{
+#ifdef __GLIBC__
+    return true;
+#else
+    return false;
+#endif
+}
+
+quint64 count()
+{
+    return s_count.load(std::memory_order_relaxed);
+}
+}
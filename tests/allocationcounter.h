@@ -0,0 +1,25 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+// Counts the heap allocations of the process, which means linking
+// allocationcounter.cpp into the test.
+
+namespace AllocationCounter
+{
+// Whether allocations are counted at all, which needs glibc
+bool isAvailable();
+
+// Calls of malloc(), calloc() and realloc() so far, including the ones
+// made by operator new and by Qt's containers
+quint64 count();
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "blurhash.h"
+
+#include <QTest>
+
+class BlurHashTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void invalid_data();
+    void invalid();
+    void averageColor_data();
+    void averageColor();
+    void components();
+    void punch();
+    void size();
+};
+
+// The example of https://blurha.sh, with 4x3 components
+static const QString s_example = QStringLiteral("LEHV6nWB2yk8pyo0adR*.7kCMdnj");
+// Mid gray plus the first horizontal component in red, at the largest value
+static const QString s_redGradient = QStringLiteral("1~Eyb[|c");
+
+// Whether the colors are the same, give or take rounding
+static bool isClose(const QColor &a, const QColor &b)
+{
+    return qAbs(a.red() - b.red()) <= 1 && qAbs(a.green() - b.green()) <= 1 && qAbs(a.blue() - b.blue()) <= 1;
+}
+
+void BlurHashTest::invalid_data()
+{
+    QTest::addColumn<QString>("hash");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("too short") << QStringLiteral("00TI:");
+    QTest::newRow("too long for the components") << QStringLiteral("00TI:j00");
+    QTest::newRow("too short for the components") << s_example.chopped(2);
+    QTest::newRow("outside of the alphabet") << QStringLiteral("00TI\"j");
+    QTest::newRow("outside of the alphabet in a component") << QStringLiteral("1~Eyb[ c");
+}
+
+void BlurHashTest::invalid()
+{
+    QFETCH(QString, hash);
+    QVERIFY(BlurHash::decode(hash).isNull());
+}
+
+void BlurHashTest::averageColor_data()
+{
+    QTest::addColumn<QString>("hash");
+    QTest::addColumn<QColor>("color");
+
+    QTest::newRow("red") << QStringLiteral("00TI:j") << QColor(255, 0, 0);
+    QTest::newRow("gray") << QStringLiteral("00Eyb[") << QColor(128, 128, 128);
+}
+
+void BlurHashTest::averageColor()
+{
+    QFETCH(QString, hash);
+    QFETCH(QColor, color);
+
+    // Without other components, the whole image has the average color
+    const QImage image = BlurHash::decode(hash, QSize(8, 8));
+    QCOMPARE(image.size(), QSize(8, 8));
+    for (const QPoint point : {QPoint(0, 0), QPoint(7, 0), QPoint(3, 4), QPoint(7, 7)}) {
+        QVERIFY2(isClose(image.pixelColor(point), color), qPrintable(image.pixelColor(point).name()));
+    }
+}
+
+void BlurHashTest::components()
+{
+    const QImage image = BlurHash::decode(s_redGradient);
+    QVERIFY(!image.isNull());
+
+    // The cosine is largest on the left and smallest on the right, and constant vertically
+    const QColor left = image.pixelColor(0, 16);
+    const QColor right = image.pixelColor(31, 16);
+    QVERIFY(left.red() > 200);
+    QCOMPARE(right.red(), 0);
+    QVERIFY(isClose(left, QColor(left.red(), 128, 128)));
+    QVERIFY(isClose(right, QColor(0, 128, 128)));
+    QCOMPARE(image.pixelColor(0, 0), left);
+    QCOMPARE(image.pixelColor(0, 31), left);
+}
+
+void BlurHashTest::punch()
+{
+    // Scales the components other than the average
+    const QImage flat = BlurHash::decode(s_redGradient, QSize(32, 32), 0);
+    QVERIFY(isClose(flat.pixelColor(0, 0), QColor(128, 128, 128)));
+    QVERIFY(isClose(flat.pixelColor(31, 0), QColor(128, 128, 128)));
+
+    const QImage example = BlurHash::decode(s_example);
+    QVERIFY(example.pixelColor(0, 0) != example.pixelColor(31, 31));
+    const QImage flatExample = BlurHash::decode(s_example, QSize(32, 32), 0);
+    QCOMPARE(flatExample.pixelColor(0, 0), flatExample.pixelColor(31, 31));
+}
+
+void BlurHashTest::size()
+{
+    QCOMPARE(BlurHash::decode(s_example).size(), QSize(32, 32));
+    QCOMPARE(BlurHash::decode(s_example, QSize(7, 3)).size(), QSize(7, 3));
+    QVERIFY(BlurHash::decode(s_example, QSize(0, 3)).isNull());
+}
+
+QTEST_GUILESS_MAIN(BlurHashTest)
+
+#include "blurhashtest.moc"
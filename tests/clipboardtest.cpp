@@ -0,0 +1,169 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "allocationcounter.h"
+#include "clipboard.h"
+
+#include <QGuiApplication>
+#include <QMimeData>
+#include <QSignalSpy>
+#include <QTest>
+#include <QUrl>
+
+class ClipboardTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void initMain()
+    {
+        // The in-process clipboard of the offscreen platform doesn't touch the one of the session
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+private Q_SLOTS:
+    void roundTrip_data();
+    void roundTrip();
+    void allocations_data();
+    void allocations();
+    void textFormats_data();
+    void textFormats();
+    void contentChanged();
+    void clear();
+
+private:
+    void addContentRows();
+};
+
+static QVariantList urlList(int count)
+{
+    QVariantList urls;
+    for (int i = 0; i < count; ++i) {
+        urls.append(QUrl(QStringLiteral("file:///tmp/clipboardtest/file%1.txt").arg(i)));
+    }
+    return urls;
+}
+
+void ClipboardTest::addContentRows()
+{
+    QTest::addColumn<QVariant>("content");
+
+    QTest::newRow("text") << QVariant(QStringLiteral("The quick brown fox jumps over the lazy dog"));
+    QTest::newRow("urls 1") << QVariant(urlList(1));
+    QTest::newRow("urls 10") << QVariant(urlList(10));
+    QTest::newRow("urls 1000") << QVariant(urlList(1000));
+}
+
+void ClipboardTest::roundTrip_data()
+{
+    addContentRows();
+}
+
+void ClipboardTest::roundTrip()
+{
+    QFETCH(QVariant, content);
+
+    Clipboard clipboard;
+    clipboard.setContent(content);
+    QCOMPARE(clipboard.content(), content);
+
+    QBENCHMARK {
+        clipboard.setContent(content);
+        clipboard.content();
+    }
+}
+
+void ClipboardTest::allocations_data()
+{
+    addContentRows();
+}
+
+void ClipboardTest::allocations()
+{
+    QFETCH(QVariant, content);
+
+    if (!AllocationCounter::isAvailable()) {
+        QSKIP("Counting allocations needs glibc");
+    }
+
+    Clipboard clipboard;
+    // Not counting the first round trip, which creates the backend
+    clipboard.setContent(content);
+    clipboard.content();
+
+    constexpr int rounds = 100;
+    const quint64 before = AllocationCounter::count();
+    for (int i = 0; i < rounds; ++i) {
+        clipboard.setContent(content);
+        clipboard.content();
+    }
+    const quint64 allocations = AllocationCounter::count() - before;
+
+    // Heap allocations per round trip
+    QTest::setBenchmarkResult(qreal(allocations) / rounds, QTest::Events);
+}
+
+void ClipboardTest::textFormats_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<QVariant>("expected");
+
+    QTest::newRow("text/plain") << QStringLiteral("text/plain") << QVariant(QStringLiteral("plain"));
+    QTest::newRow("uri-list") << QStringLiteral("text/uri-list") << QVariant(QVariantList{QUrl(QStringLiteral("https://kde.org"))});
+}
+
+void ClipboardTest::textFormats()
+{
+    QFETCH(QString, format);
+    QFETCH(QVariant, expected);
+
+    auto *mimeData = new QMimeData;
+    mimeData->setText(QStringLiteral("plain"));
+    mimeData->setUrls({QUrl(QStringLiteral("https://kde.org"))});
+    QGuiApplication::clipboard()->setMimeData(mimeData);
+
+    Clipboard clipboard;
+    QVERIFY(clipboard.formats().contains(format));
+    QCOMPARE(clipboard.contentFormat(format), expected);
+}
+
+void ClipboardTest::contentChanged()
+{
+    Clipboard first;
+    Clipboard second;
+    Clipboard selection;
+    selection.setMode(QClipboard::Selection);
+
+    QSignalSpy firstSpy(&first, &Clipboard::contentChanged);
+    QSignalSpy secondSpy(&second, &Clipboard::contentChanged);
+    QSignalSpy selectionSpy(&selection, &Clipboard::contentChanged);
+
+    first.setContent(QStringLiteral("one"));
+    QTRY_COMPARE(secondSpy.count(), 1);
+    QCOMPARE(firstSpy.count(), 1);
+    QCOMPARE(selectionSpy.count(), 0);
+    QCOMPARE(second.content(), QVariant(QStringLiteral("one")));
+
+    // The content cached for the first change must not survive the second one
+    second.setContent(QStringLiteral("two"));
+    QTRY_COMPARE(firstSpy.count(), 2);
+    QCOMPARE(first.content(), QVariant(QStringLiteral("two")));
+}
+
+void ClipboardTest::clear()
+{
+    Clipboard clipboard;
+    clipboard.setContent(QStringLiteral("something"));
+    QCOMPARE(clipboard.content(), QVariant(QStringLiteral("something")));
+
+    clipboard.clear();
+    QVERIFY(clipboard.formats().isEmpty());
+    QVERIFY(!clipboard.content().isValid());
+}
+
+QTEST_MAIN(ClipboardTest)
+
+#include "clipboardtest.moc"
@@ -0,0 +1,147 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "DeclarativeMimeData.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+class DeclarativeMimeDataTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void payload();
+    void textReplacesPayload();
+    void textChanged();
+    void urlsReplacePayload();
+    void colorReplacesPayload();
+    void bytesReplacePayload();
+    void payloadReplacesBytes();
+    void copy();
+};
+
+void DeclarativeMimeDataTest::payload()
+{
+    DeclarativeMimeData data;
+    QObject object;
+    data.setData(QStringLiteral("application/x-object"), QVariant::fromValue(&object));
+    data.setData(QStringLiteral("application/x-number"), 42);
+
+    QCOMPARE(data.formats().count(QStringLiteral("application/x-object")), 1);
+    QCOMPARE(data.getData(QStringLiteral("application/x-object")).value<QObject *>(), &object);
+    QCOMPARE(data.getData(QStringLiteral("application/x-number")), QVariant(42));
+    // Serialized only when asked for the bytes
+    QCOMPARE(data.data(QStringLiteral("application/x-number")), QByteArray("42"));
+    QVERIFY(data.data(QStringLiteral("application/x-object")).isEmpty());
+}
+
+void DeclarativeMimeDataTest::textReplacesPayload()
+{
+    DeclarativeMimeData data;
+    data.setData(QStringLiteral("text/plain"), 42);
+    data.setText(QStringLiteral("text"));
+
+    QCOMPARE(data.formats().count(QStringLiteral("text/plain")), 1);
+    QCOMPARE(data.text(), QStringLiteral("text"));
+    QCOMPARE(data.getData(QStringLiteral("text/plain")), QVariant(QByteArray("text")));
+
+    data.setData(QStringLiteral("text/html"), 42);
+    data.setHtml(QStringLiteral("<b>html</b>"));
+    QCOMPARE(data.formats().count(QStringLiteral("text/html")), 1);
+    QCOMPARE(data.html(), QStringLiteral("<b>html</b>"));
+}
+
+void DeclarativeMimeDataTest::textChanged()
+{
+    DeclarativeMimeData data;
+    QSignalSpy textSpy(&data, &DeclarativeMimeData::textChanged);
+    QSignalSpy htmlSpy(&data, &DeclarativeMimeData::htmlChanged);
+
+    data.setText(QStringLiteral("text"));
+    data.setText(QStringLiteral("text"));
+    QCOMPARE(textSpy.count(), 1);
+
+    data.setHtml(QStringLiteral("<b>html</b>"));
+    data.setHtml(QStringLiteral("<b>html</b>"));
+    QCOMPARE(htmlSpy.count(), 1);
+    QCOMPARE(textSpy.count(), 1);
+}
+
+void DeclarativeMimeDataTest::urlsReplacePayload()
+{
+    DeclarativeMimeData data;
+    data.setData(QStringLiteral("text/uri-list"), QStringLiteral("file:///stale"));
+    data.setUrls(QJsonArray{QStringLiteral("file:///a"), QStringLiteral("file:///b")});
+
+    QCOMPARE(data.formats().count(QStringLiteral("text/uri-list")), 1);
+    QCOMPARE(data.urls(), (QJsonArray{QStringLiteral("file:///a"), QStringLiteral("file:///b")}));
+
+    data.setData(QStringLiteral("text/uri-list"), QStringLiteral("file:///stale"));
+    data.setUrl(QUrl(QStringLiteral("file:///c")));
+    QCOMPARE(data.formats().count(QStringLiteral("text/uri-list")), 1);
+    QCOMPARE(data.url(), QUrl(QStringLiteral("file:///c")));
+}
+
+void DeclarativeMimeDataTest::colorReplacesPayload()
+{
+    DeclarativeMimeData data;
+    data.setData(QStringLiteral("application/x-color"), QStringLiteral("stale"));
+    data.setColor(Qt::red);
+
+    QCOMPARE(data.formats().count(QStringLiteral("application/x-color")), 1);
+    QCOMPARE(data.color(), QColor(Qt::red));
+}
+
+void DeclarativeMimeDataTest::bytesReplacePayload()
+{
+    DeclarativeMimeData data;
+    data.setData(QStringLiteral("application/x-foo"), 42);
+
+    // Bytes set through QMimeData, which the payloads can't intercept
+    static_cast<QMimeData &>(data).setData(QStringLiteral("application/x-foo"), QByteArray("bytes"));
+    QCOMPARE(data.formats().count(QStringLiteral("application/x-foo")), 1);
+    QCOMPARE(data.data(QStringLiteral("application/x-foo")), QByteArray("bytes"));
+    QCOMPARE(data.getData(QStringLiteral("application/x-foo")), QVariant(QByteArray("bytes")));
+
+    // Byte arrays given to setData() are stored as bytes as well
+    data.setData(QStringLiteral("application/x-bar"), 42);
+    data.setData(QStringLiteral("application/x-bar"), QByteArray("bar"));
+    QCOMPARE(data.formats().count(QStringLiteral("application/x-bar")), 1);
+    QCOMPARE(data.getData(QStringLiteral("application/x-bar")), QVariant(QByteArray("bar")));
+}
+
+void DeclarativeMimeDataTest::payloadReplacesBytes()
+{
+    DeclarativeMimeData data;
+    data.setText(QStringLiteral("text"));
+    data.setData(QStringLiteral("text/plain"), QStringLiteral("payload"));
+
+    QCOMPARE(data.formats().count(QStringLiteral("text/plain")), 1);
+    QCOMPARE(data.getData(QStringLiteral("text/plain")), QVariant(QStringLiteral("payload")));
+    QCOMPARE(data.text(), QStringLiteral("payload"));
+}
+
+void DeclarativeMimeDataTest::copy()
+{
+    DeclarativeMimeData data;
+    QObject object;
+    data.setData(QStringLiteral("application/x-object"), QVariant::fromValue(&object));
+    data.setData(QStringLiteral("application/x-foo"), 42);
+    static_cast<QMimeData &>(data).setData(QStringLiteral("application/x-foo"), QByteArray("bytes"));
+    data.setText(QStringLiteral("text"));
+
+    const DeclarativeMimeData copy(&data);
+    QCOMPARE(copy.formats().size(), data.formats().size());
+    QCOMPARE(copy.formats().count(QStringLiteral("application/x-foo")), 1);
+    QCOMPARE(copy.getData(QStringLiteral("application/x-object")).value<QObject *>(), &object);
+    QCOMPARE(copy.getData(QStringLiteral("application/x-foo")), QVariant(QByteArray("bytes")));
+    QCOMPARE(copy.text(), QStringLiteral("text"));
+}
+
+QTEST_GUILESS_MAIN(DeclarativeMimeDataTest)
+
+#include "declarativemimedatatest.moc"
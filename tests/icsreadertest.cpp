@@ -0,0 +1,251 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "icsreader.h"
+
+#include <QFile>
+#include <QTest>
+#include <QTimeZone>
+
+using namespace CalendarEvents;
+
+class IcsReaderTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void initMain()
+    {
+        // Floating times and the dates events are keyed with depend on the local time zone
+        qputenv("TZ", "UTC");
+    }
+
+private Q_SLOTS:
+    void unfolding();
+    void times();
+    void duration();
+    void todo();
+    void allDay();
+    void malformed();
+    void truncated();
+    void missingFile();
+
+private:
+    struct Result {
+        QDate date;
+        EventData event;
+    };
+
+    // Reads the fixture for March 2026, keyed by uid
+    QHash<QString, Result> read(const char *fixture);
+};
+
+QHash<QString, IcsReaderTest::Result> IcsReaderTest::read(const char *fixture)
+{
+    const QString fileName = QFINDTESTDATA(QStringLiteral("data/%1").arg(QLatin1String(fixture)));
+    QHash<QString, Result> results;
+    if (fileName.isEmpty()) {
+        QTest::qFail("Fixture not found", __FILE__, __LINE__);
+        return results;
+    }
+
+    const bool ok = IcsReader::readEvents(fileName, QDate(2026, 3, 1), QDate(2026, 3, 31), [&results](const QDate &date, const EventData &event) {
+        QVERIFY2(!results.contains(event.uid()), qPrintable(event.uid()));
+        results.insert(event.uid(), {date, event});
+    });
+    if (!ok) {
+        QTest::qFail("Fixture can't be read", __FILE__, __LINE__);
+    }
+    return results;
+}
+
+void IcsReaderTest::unfolding()
+{
+    const auto results = read("unfolding.ics");
+    QCOMPARE(results.size(), 2);
+
+    const EventData folded = results.value(QStringLiteral("folded@kde.org")).event;
+    // Only the single whitespace character starting the continuation line is removed
+    QCOMPARE(folded.title(), QStringLiteral("A summary that is folded over two lines"));
+    QCOMPARE(folded.description(), QStringLiteral("Escaped, text; with\nnewlines and a tab foldedcontinuation"));
+
+    // Folds within the name, the parameters and the value
+    QVERIFY(results.contains(QStringLiteral("folded-uid@kde.org")));
+    const EventData parameter = results.value(QStringLiteral("folded-uid@kde.org")).event;
+    QCOMPARE(parameter.title(), QStringLiteral("Folded parameter"));
+    QCOMPARE(parameter.startDateTime().timeSpec(), Qt::TimeZone);
+    QCOMPARE(parameter.startDateTime().timeZone().id(), QByteArray("Europe/Berlin"));
+    QCOMPARE(parameter.startDateTime(), QDateTime(QDate(2026, 3, 11), QTime(10, 0), QTimeZone("Europe/Berlin")));
+}
+
+void IcsReaderTest::times()
+{
+    const auto results = read("times.ics");
+    QCOMPARE(results.size(), 5);
+
+    const Result utc = results.value(QStringLiteral("utc@kde.org"));
+    QCOMPARE(utc.date, QDate(2026, 3, 11));
+    QCOMPARE(utc.event.startDateTime(), QDateTime(QDate(2026, 3, 11), QTime(9, 0), QTimeZone::utc()));
+    QCOMPARE(utc.event.startDateTime().timeSpec(), Qt::UTC);
+    QCOMPARE(utc.event.endDateTime(), QDateTime(QDate(2026, 3, 11), QTime(10, 0), QTimeZone::utc()));
+    QVERIFY(!utc.event.isAllDay());
+    QCOMPARE(utc.event.type(), EventData::Event);
+
+    const QTimeZone berlin("Europe/Berlin");
+    const Result tzid = results.value(QStringLiteral("tzid@kde.org"));
+    QCOMPARE(tzid.event.startDateTime(), QDateTime(QDate(2026, 3, 12), QTime(10, 0), berlin));
+    QCOMPARE(tzid.event.startDateTime().timeZone(), berlin);
+    QCOMPARE(tzid.event.endDateTime(), QDateTime(QDate(2026, 3, 12), QTime(11, 30), berlin));
+
+    const Result quoted = results.value(QStringLiteral("quoted-tzid@kde.org"));
+    QCOMPARE(quoted.event.startDateTime().timeZone().id(), QByteArray("America/New_York"));
+    QCOMPARE(quoted.event.startDateTime(), QDateTime(QDate(2026, 3, 13), QTime(8, 0), QTimeZone("America/New_York")));
+    // Without an end, the event ends when it starts
+    QCOMPARE(quoted.event.endDateTime(), quoted.event.startDateTime());
+
+    const Result floating = results.value(QStringLiteral("floating@kde.org"));
+    QCOMPARE(floating.event.startDateTime().timeSpec(), Qt::LocalTime);
+    QCOMPARE(floating.event.startDateTime(), QDateTime(QDate(2026, 3, 14), QTime(15, 0)));
+    QCOMPARE(floating.event.endDateTime(), QDateTime(QDate(2026, 3, 14), QTime(16, 0)));
+
+    // Unknown time zones are read as floating times
+    const Result unknown = results.value(QStringLiteral("unknown-tzid@kde.org"));
+    QCOMPARE(unknown.event.startDateTime().timeSpec(), Qt::LocalTime);
+    QCOMPARE(unknown.event.startDateTime(), QDateTime(QDate(2026, 3, 15), QTime(10, 0)));
+}
+
+void IcsReaderTest::duration()
+{
+    const auto results = read("duration.ics");
+    QCOMPARE(results.size(), 4);
+
+    const EventData timed = results.value(QStringLiteral("timed@kde.org")).event;
+    QCOMPARE(timed.startDateTime(), QDateTime(QDate(2026, 3, 16), QTime(10, 0), QTimeZone::utc()));
+    QCOMPARE(timed.endDateTime(), QDateTime(QDate(2026, 3, 16), QTime(11, 30), QTimeZone::utc()));
+
+    const EventData days = results.value(QStringLiteral("days@kde.org")).event;
+    QCOMPARE(days.endDateTime(), QDateTime(QDate(2026, 3, 18), QTime(12, 0), QTimeZone::utc()));
+
+    // Like DTEND, the end of an all-day duration is exclusive
+    const Result allDay = results.value(QStringLiteral("all-day@kde.org"));
+    QCOMPARE(allDay.date, QDate(2026, 3, 17));
+    QCOMPARE(allDay.event.endDateTime().date(), QDate(2026, 3, 17));
+    QVERIFY(allDay.event.isAllDay());
+
+    const Result week = results.value(QStringLiteral("week@kde.org"));
+    QCOMPARE(week.event.startDateTime().date(), QDate(2026, 3, 18));
+    QCOMPARE(week.event.endDateTime().date(), QDate(2026, 3, 24));
+    QVERIFY(!week.event.isAllDay());
+}
+
+void IcsReaderTest::todo()
+{
+    const auto results = read("todo.ics");
+    // Todos without any date can't be shown in the calendar
+    QCOMPARE(results.size(), 2);
+    QVERIFY(!results.contains(QStringLiteral("undated@kde.org")));
+
+    const Result due = results.value(QStringLiteral("due@kde.org"));
+    QCOMPARE(due.event.type(), EventData::Todo);
+    QCOMPARE(due.date, QDate(2026, 3, 20));
+    QCOMPARE(due.event.startDateTime(), QDateTime(QDate(2026, 3, 20), QTime(17, 0), QTimeZone::utc()));
+    QCOMPARE(due.event.endDateTime(), due.event.startDateTime());
+
+    const Result startDue = results.value(QStringLiteral("start-due@kde.org"));
+    QCOMPARE(startDue.event.type(), EventData::Todo);
+    QCOMPARE(startDue.date, QDate(2026, 3, 18));
+    QCOMPARE(startDue.event.startDateTime(), QDateTime(QDate(2026, 3, 18), QTime(9, 0), QTimeZone::utc()));
+    QCOMPARE(startDue.event.endDateTime(), QDateTime(QDate(2026, 3, 19), QTime(17, 0), QTimeZone::utc()));
+}
+
+void IcsReaderTest::allDay()
+{
+    const auto results = read("allday.ics");
+    QCOMPARE(results.size(), 4);
+
+    // DTEND is exclusive: a single day event ends on the day it starts
+    const Result single = results.value(QStringLiteral("single@kde.org"));
+    QCOMPARE(single.date, QDate(2026, 3, 10));
+    QCOMPARE(single.event.startDateTime().date(), QDate(2026, 3, 10));
+    QCOMPARE(single.event.endDateTime().date(), QDate(2026, 3, 10));
+    QVERIFY(single.event.isAllDay());
+
+    // EventData is only all-day for single day events
+    const Result multi = results.value(QStringLiteral("multi@kde.org"));
+    QCOMPARE(multi.date, QDate(2026, 3, 10));
+    QCOMPARE(multi.event.endDateTime().date(), QDate(2026, 3, 12));
+    QVERIFY(!multi.event.isAllDay());
+
+    const Result noEnd = results.value(QStringLiteral("no-end@kde.org"));
+    QCOMPARE(noEnd.event.endDateTime().date(), QDate(2026, 3, 25));
+    QVERIFY(noEnd.event.isAllDay());
+
+    // Events intersecting the range are reported for the day they start on
+    QVERIFY(!results.contains(QStringLiteral("before@kde.org")));
+    QVERIFY(!results.contains(QStringLiteral("after@kde.org")));
+    const Result into = results.value(QStringLiteral("into@kde.org"));
+    QCOMPARE(into.date, QDate(2026, 2, 27));
+    QCOMPARE(into.event.endDateTime().date(), QDate(2026, 3, 2));
+}
+
+void IcsReaderTest::malformed()
+{
+    const auto results = read("malformed.ics");
+    QCOMPARE(results.size(), 3);
+
+    // Components without a valid start are dropped
+    QVERIFY(!results.contains(QStringLiteral("not-a-date@kde.org")));
+    QVERIFY(!results.contains(QStringLiteral("bad-month@kde.org")));
+
+    const EventData badDuration = results.value(QStringLiteral("bad-duration@kde.org")).event;
+    QCOMPARE(badDuration.endDateTime(), badDuration.startDateTime());
+
+    const EventData endBeforeStart = results.value(QStringLiteral("end-before-start@kde.org")).event;
+    QCOMPARE(endBeforeStart.endDateTime(), endBeforeStart.startDateTime());
+
+    // Lines without a value are skipped, the properties of the alarm don't leak into the event
+    // and the leap second is clamped
+    const EventData alarm = results.value(QStringLiteral("alarm@kde.org")).event;
+    QCOMPARE(alarm.title(), QStringLiteral("With an alarm"));
+    QVERIFY(alarm.description().isEmpty());
+    QCOMPARE(alarm.startDateTime(), QDateTime(QDate(2026, 3, 12), QTime(23, 59, 59), QTimeZone::utc()));
+}
+
+void IcsReaderTest::truncated()
+{
+    const auto results = read("truncated.ics");
+    // The component cut off before its END is never reported
+    QCOMPARE(results.size(), 1);
+    QVERIFY(results.contains(QStringLiteral("complete@kde.org")));
+
+    // Nor are components cut off at any other point
+    const QString fileName = QFINDTESTDATA("data/truncated.ics");
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray data = file.readAll();
+    for (qsizetype size = 0; size <= data.size(); ++size) {
+        int count = 0;
+        IcsReader::readEvents(QByteArrayView(data).first(size), QDate(2026, 3, 1), QDate(2026, 3, 31), [&count](const QDate &, const EventData &event) {
+            QCOMPARE(event.uid(), QStringLiteral("complete@kde.org"));
+            ++count;
+        });
+        QVERIFY(count <= 1);
+    }
+}
+
+void IcsReaderTest::missingFile()
+{
+    bool called = false;
+    QVERIFY(!IcsReader::readEvents(QStringLiteral("/does/not/exist.ics"), QDate(2026, 3, 1), QDate(2026, 3, 31), [&called](const QDate &, const EventData &) {
+        called = true;
+    }));
+    QVERIFY(!called);
+    QVERIFY(IcsReader::readEvents(QStringLiteral("/does/not/exist.ics"), QDate(2026, 3, 1), QDate(2026, 3, 31)).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(IcsReaderTest)
+
+#include "icsreadertest.moc"
@@ -0,0 +1,154 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "imageanalysis.h"
+
+#include <QPainter>
+#include <QTest>
+
+class ImageAnalysisTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void isOpaque_data();
+    void isOpaque();
+    void extractColorsNull();
+    void extractColorsSingleColor();
+    void extractColorsProportions();
+    void extractColorsTransparency();
+    void extractColorsPaletteSize();
+};
+
+// An opaque image of 37x5 pixels, wider than a few SIMD blocks but not a multiple of them
+static QImage opaqueImage(QImage::Format format)
+{
+    QImage image(37, 5, format);
+    image.fill(QColor(10, 20, 30));
+    return image;
+}
+
+// The same with the pixel at x, y almost opaque
+static QImage translucentImage(QImage::Format format, int x, int y)
+{
+    QImage image = opaqueImage(format);
+    image.setPixelColor(x, y, QColor(10, 20, 30, 254));
+    return image;
+}
+
+void ImageAnalysisTest::isOpaque_data()
+{
+    QTest::addColumn<QImage>("image");
+    QTest::addColumn<bool>("opaque");
+
+    QTest::newRow("null") << QImage() << false;
+    QTest::newRow("no alpha channel") << opaqueImage(QImage::Format_RGB32) << true;
+    QTest::newRow("RGB888") << opaqueImage(QImage::Format_RGB888) << true;
+
+    for (const QImage::Format format : {QImage::Format_ARGB32, QImage::Format_ARGB32_Premultiplied, QImage::Format_RGBA8888, QImage::Format_RGBA8888_Premultiplied}) {
+        const QByteArray name = QByteArray::number(int(format));
+        QTest::addRow("%s opaque", name.constData()) << opaqueImage(format) << true;
+        QTest::addRow("%s first pixel", name.constData()) << translucentImage(format, 0, 0) << false;
+        QTest::addRow("%s within a block", name.constData()) << translucentImage(format, 21, 2) << false;
+        QTest::addRow("%s in the tail", name.constData()) << translucentImage(format, 35, 3) << false;
+        QTest::addRow("%s last pixel", name.constData()) << translucentImage(format, 36, 4) << false;
+    }
+
+    // Not scanned, so not known to be opaque
+    QTest::newRow("ARGB4444") << opaqueImage(QImage::Format_ARGB4444_Premultiplied) << false;
+}
+
+void ImageAnalysisTest::isOpaque()
+{
+    QFETCH(QImage, image);
+    QFETCH(bool, opaque);
+
+    QCOMPARE(ImageAnalysis::isOpaque(image), opaque);
+}
+
+// Whether the colors are the same, give or take the 5 bits per channel of the histogram
+static bool isClose(const QColor &a, const QColor &b)
+{
+    return qAbs(a.red() - b.red()) <= 4 && qAbs(a.green() - b.green()) <= 4 && qAbs(a.blue() - b.blue()) <= 4;
+}
+
+void ImageAnalysisTest::extractColorsNull()
+{
+    const ImageAnalysis::Colors colors = ImageAnalysis::extractColors(QImage(), 5);
+    QVERIFY(!colors.average.isValid());
+    QVERIFY(colors.palette.isEmpty());
+}
+
+void ImageAnalysisTest::extractColorsSingleColor()
+{
+    // Larger than what is analyzed, in a format which needs converting
+    QImage image(300, 200, QImage::Format_RGB888);
+    image.fill(QColor(200, 100, 50));
+
+    const ImageAnalysis::Colors colors = ImageAnalysis::extractColors(image, 5);
+    QCOMPARE(colors.average, QColor(200, 100, 50));
+    QCOMPARE(colors.palette.size(), 1);
+    QVERIFY2(isClose(colors.palette.first(), QColor(200, 100, 50)), qPrintable(colors.palette.first().name()));
+}
+
+void ImageAnalysisTest::extractColorsProportions()
+{
+    // Three quarters blue, one quarter red
+    QImage image(40, 40, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+    QPainter painter(&image);
+    painter.fillRect(0, 0, 40, 10, Qt::red);
+    painter.end();
+
+    const ImageAnalysis::Colors colors = ImageAnalysis::extractColors(image, 5);
+    QCOMPARE(colors.palette.size(), 2);
+    QVERIFY(isClose(colors.palette.at(0), Qt::blue));
+    QVERIFY(isClose(colors.palette.at(1), Qt::red));
+    QVERIFY(isClose(colors.average, QColor(64, 0, 191)));
+}
+
+void ImageAnalysisTest::extractColorsTransparency()
+{
+    // Half transparent red, half opaque green
+    QImage image(40, 40, QImage::Format_ARGB32);
+    image.fill(Qt::green);
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 40; ++x) {
+            image.setPixelColor(x, y, QColor(255, 0, 0, 0));
+        }
+    }
+
+    const ImageAnalysis::Colors colors = ImageAnalysis::extractColors(image, 5);
+    QCOMPARE(colors.palette.size(), 1);
+    QVERIFY(isClose(colors.palette.first(), Qt::green));
+    // Weighted by opacity, so only green, at half of the opacity
+    QVERIFY(isClose(colors.average, Qt::green));
+    QVERIFY(qAbs(colors.average.alpha() - 127) <= 1);
+
+    image.fill(Qt::transparent);
+    const ImageAnalysis::Colors transparent = ImageAnalysis::extractColors(image, 5);
+    QVERIFY(!transparent.average.isValid());
+    QVERIFY(transparent.palette.isEmpty());
+}
+
+void ImageAnalysisTest::extractColorsPaletteSize()
+{
+    // Eight stripes of very different colors
+    QImage image(64, 8, QImage::Format_RGB32);
+    QPainter painter(&image);
+    for (int i = 0; i < 8; ++i) {
+        painter.fillRect(i * 8, 0, 8, 8, QColor(i & 1 ? 255 : 0, i & 2 ? 255 : 0, i & 4 ? 255 : 0));
+    }
+    painter.end();
+
+    QCOMPARE(ImageAnalysis::extractColors(image, 5).palette.size(), 5);
+    QCOMPARE(ImageAnalysis::extractColors(image, 8).palette.size(), 8);
+    QCOMPARE(ImageAnalysis::extractColors(image, 16).palette.size(), 8);
+}
+
+QTEST_GUILESS_MAIN(ImageAnalysisTest)
+
+#include "imageanalysistest.moc"
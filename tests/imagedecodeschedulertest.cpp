@@ -0,0 +1,242 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "imagedecodescheduler.h"
+
+#include <QCoreApplication>
+#include <QRegularExpression>
+#include <QSemaphore>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThreadPool>
+
+class ImageDecodeSchedulerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanup();
+    void decode();
+    void scaledSize();
+    void coalesced();
+    void differentSizes();
+    void cancelOne();
+    void cancelAll();
+    void deletedReceiver();
+    void missingFile();
+    void scale();
+
+private:
+    // Keeps the only worker thread busy, so requests queue up until release()
+    void block();
+    void release();
+
+    QTemporaryDir m_dir;
+    QUrl m_source;
+    QSemaphore m_blocker;
+    bool m_blocked = false;
+};
+
+struct Result {
+    int calls = 0;
+    QImage image;
+};
+
+void ImageDecodeSchedulerTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QImage image(200, 100, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    const QString fileName = m_dir.filePath(QStringLiteral("image.png"));
+    QVERIFY(image.save(fileName));
+    m_source = QUrl::fromLocalFile(fileName);
+
+    QThreadPool::globalInstance()->setMaxThreadCount(1);
+}
+
+void ImageDecodeSchedulerTest::cleanup()
+{
+    if (m_blocked) {
+        release();
+    }
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+}
+
+void ImageDecodeSchedulerTest::block()
+{
+    QThreadPool::globalInstance()->start([this]() {
+        m_blocker.acquire();
+    });
+    m_blocked = true;
+}
+
+void ImageDecodeSchedulerTest::release()
+{
+    m_blocker.release();
+    m_blocked = false;
+}
+
+static ImageDecodeScheduler::Callback collect(Result *result)
+{
+    return [result](const QImage &image, QImageIOHandler::Transformations transformation) {
+        Q_UNUSED(transformation);
+        ++result->calls;
+        result->image = image;
+    };
+}
+
+void ImageDecodeSchedulerTest::decode()
+{
+    Result result;
+    const quint64 ticket = ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&result));
+    QVERIFY(ticket != 0);
+
+    QTRY_COMPARE(result.calls, 1);
+    QCOMPARE(result.image.size(), QSize(200, 100));
+    QCOMPARE(result.image.pixelColor(0, 0), QColor(Qt::red));
+}
+
+void ImageDecodeSchedulerTest::scaledSize()
+{
+    Result fit;
+    Result width;
+    Result dpr;
+    ImageDecodeScheduler::instance()->request(m_source, QSize(50, 50), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&fit));
+    ImageDecodeScheduler::instance()->request(m_source, QSize(100, 0), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&width));
+    ImageDecodeScheduler::instance()->request(m_source, QSize(50, 50), 2, ImageDecodeScheduler::IgnoreTransformation, this, collect(&dpr));
+
+    QTRY_COMPARE(dpr.calls, 1);
+    QCOMPARE(fit.image.size(), QSize(50, 25));
+    QCOMPARE(width.image.size(), QSize(100, 50));
+    QCOMPARE(dpr.image.size(), QSize(100, 50));
+    QCOMPARE(dpr.image.devicePixelRatio(), 2.0);
+}
+
+void ImageDecodeSchedulerTest::coalesced()
+{
+    block();
+    Result first;
+    Result second;
+    Result natural;
+    ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&first));
+    ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&second));
+    // Another way of asking for the natural size
+    ImageDecodeScheduler::instance()->request(m_source, QSize(-1, -1), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&natural));
+    release();
+
+    QTRY_COMPARE(natural.calls, 1);
+    QCOMPARE(first.calls, 1);
+    QCOMPARE(second.calls, 1);
+    // One decode, whose pixels all of them share
+    QCOMPARE(second.image.cacheKey(), first.image.cacheKey());
+    QCOMPARE(natural.image.cacheKey(), first.image.cacheKey());
+
+    // Requests after the decode finished decode again
+    Result later;
+    ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&later));
+    QTRY_COMPARE(later.calls, 1);
+    QVERIFY(later.image.cacheKey() != first.image.cacheKey());
+}
+
+void ImageDecodeSchedulerTest::differentSizes()
+{
+    block();
+    Result small;
+    Result big;
+    ImageDecodeScheduler::instance()->request(m_source, QSize(50, 50), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&small));
+    ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&big));
+    release();
+
+    QTRY_COMPARE(big.calls, 1);
+    QTRY_COMPARE(small.calls, 1);
+    QCOMPARE(small.image.size(), QSize(50, 25));
+    QCOMPARE(big.image.size(), QSize(200, 100));
+}
+
+void ImageDecodeSchedulerTest::cancelOne()
+{
+    block();
+    Result cancelled;
+    Result kept;
+    const quint64 ticket = ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&cancelled));
+    ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&kept));
+    ImageDecodeScheduler::instance()->cancel(ticket);
+    release();
+
+    QTRY_COMPARE(kept.calls, 1);
+    QCOMPARE(cancelled.calls, 0);
+
+    // Cancelling a finished request does nothing
+    ImageDecodeScheduler::instance()->cancel(ticket);
+}
+
+void ImageDecodeSchedulerTest::cancelAll()
+{
+    block();
+    Result cancelled;
+    const quint64 ticket = ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&cancelled));
+    ImageDecodeScheduler::instance()->cancel(ticket);
+
+    // A new request doesn't join the dropped decode
+    Result fresh;
+    ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&fresh));
+    release();
+
+    QTRY_COMPARE(fresh.calls, 1);
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    QCOMPARE(cancelled.calls, 0);
+}
+
+void ImageDecodeSchedulerTest::deletedReceiver()
+{
+    block();
+    Result orphaned;
+    Result kept;
+    auto *receiver = new QObject;
+    ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, receiver, collect(&orphaned));
+    ImageDecodeScheduler::instance()->request(m_source, QSize(), 1, ImageDecodeScheduler::IgnoreTransformation, this, collect(&kept));
+    delete receiver;
+    release();
+
+    QTRY_COMPARE(kept.calls, 1);
+    QCOMPARE(orphaned.calls, 0);
+}
+
+void ImageDecodeSchedulerTest::missingFile()
+{
+    Result result;
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("^Could not load")));
+    ImageDecodeScheduler::instance()->request(QUrl::fromLocalFile(m_dir.filePath(QStringLiteral("missing.png"))),
+                                              QSize(),
+                                              1,
+                                              ImageDecodeScheduler::IgnoreTransformation,
+                                              this,
+                                              collect(&result));
+
+    QTRY_COMPARE(result.calls, 1);
+    QVERIFY(result.image.isNull());
+}
+
+void ImageDecodeSchedulerTest::scale()
+{
+    QImage image(200, 100, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+
+    QImage scaled;
+    ImageDecodeScheduler::instance()->scale(image, QSize(20, 20), this, [&scaled](const QImage &result) {
+        scaled = result;
+    });
+    QTRY_VERIFY(!scaled.isNull());
+    QCOMPARE(scaled.size(), QSize(20, 20));
+    QCOMPARE(scaled.pixelColor(10, 10), QColor(Qt::blue));
+}
+
+QTEST_GUILESS_MAIN(ImageDecodeSchedulerTest)
+
+#include "imagedecodeschedulertest.moc"
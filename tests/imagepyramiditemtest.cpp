@@ -0,0 +1,114 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "imagepyramiditem.h"
+
+#include <QPainter>
+#include <QQuickWindow>
+#include <QTest>
+
+class ImagePyramidItemTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void initMain()
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+        // Grabbing the window reads back what the tiles rendered
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    }
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+    void fullResolution();
+    void downscaled();
+    void scrolled();
+
+private:
+    // Four quadrants, each of a single color, not aligned to the tiles
+    static QImage quadrants(const QSize &size);
+
+    QQuickWindow *m_window = nullptr;
+    ImagePyramidItem *m_item = nullptr;
+};
+
+QImage ImagePyramidItemTest::quadrants(const QSize &size)
+{
+    QImage image(size, QImage::Format_RGB32);
+    QPainter painter(&image);
+    const int w = size.width() / 2;
+    const int h = size.height() / 2;
+    painter.fillRect(0, 0, w, h, Qt::red);
+    painter.fillRect(w, 0, size.width() - w, h, Qt::green);
+    painter.fillRect(0, h, w, size.height() - h, Qt::blue);
+    painter.fillRect(w, h, size.width() - w, size.height() - h, Qt::yellow);
+    return image;
+}
+
+void ImagePyramidItemTest::init()
+{
+    m_window = new QQuickWindow;
+    m_window->resize(200, 200);
+
+    m_item = new ImagePyramidItem(m_window->contentItem());
+    m_item->setSize(QSizeF(200, 200));
+
+    m_window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_window));
+}
+
+void ImagePyramidItemTest::cleanup()
+{
+    delete m_window;
+    m_window = nullptr;
+}
+
+void ImagePyramidItemTest::fullResolution()
+{
+    // The colors change at 150 and the tiles meet at 256, at 50 and 156 in the window
+    m_item->setImage(quadrants(QSize(300, 300)), true);
+    m_item->setImageTransform(QTransform::fromTranslate(-100, -100));
+
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(48, 48), QColor(Qt::red));
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(51, 48), QColor(Qt::green));
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(48, 51), QColor(Qt::blue));
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(151, 151), QColor(Qt::yellow));
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(199, 199), QColor(Qt::yellow));
+}
+
+void ImagePyramidItemTest::downscaled()
+{
+    // Shown at a fifth of its size, from a level halved from the image
+    m_item->setImage(quadrants(QSize(1000, 1000)), true);
+    m_item->setImageTransform(QTransform::fromScale(0.2, 0.2));
+
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(50, 50), QColor(Qt::red));
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(150, 50), QColor(Qt::green));
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(50, 150), QColor(Qt::blue));
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(150, 150), QColor(Qt::yellow));
+}
+
+void ImagePyramidItemTest::scrolled()
+{
+    m_item->setImage(quadrants(QSize(1000, 1000)), true);
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(100, 100), QColor(Qt::red));
+
+    // Tiles that weren't visible before are built once scrolled into view
+    m_item->setImageTransform(QTransform::fromTranslate(-800, -800));
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(100, 100), QColor(Qt::yellow));
+
+    // And so are new images
+    QImage image(1000, 1000, QImage::Format_RGB32);
+    image.fill(Qt::cyan);
+    m_item->setImage(image, true);
+    QTRY_COMPARE(m_window->grabWindow().pixelColor(100, 100), QColor(Qt::cyan));
+}
+
+QTEST_MAIN(ImagePyramidItemTest)
+
+#include "imagepyramiditemtest.moc"
@@ -0,0 +1,176 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "imageuploadscheduler.h"
+
+#include <QQuickWindow>
+#include <QTest>
+
+class ImageUploadSchedulerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void initMain()
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+    void instance();
+    void budget();
+    void largestVisibleFirst();
+    void oversizedItem();
+    void replace();
+    void cancel();
+    void deletedItem();
+
+private:
+    // A 100x100 item, whose texture takes 40000 bytes
+    QQuickItem *createItem(const QPointF &position = QPointF());
+    void schedule(QQuickItem *item, const QString &name);
+    // Frames are driven by hand rather than by the render loop
+    void processFrame();
+
+    QQuickWindow *m_window = nullptr;
+    ImageUploadScheduler *m_scheduler = nullptr;
+    QStringList m_uploads;
+};
+
+void ImageUploadSchedulerTest::init()
+{
+    m_window = new QQuickWindow;
+    m_window->resize(200, 200);
+    m_scheduler = ImageUploadScheduler::instance(m_window);
+    m_uploads.clear();
+}
+
+void ImageUploadSchedulerTest::cleanup()
+{
+    delete m_window;
+    m_window = nullptr;
+}
+
+QQuickItem *ImageUploadSchedulerTest::createItem(const QPointF &position)
+{
+    auto *item = new QQuickItem(m_window->contentItem());
+    item->setPosition(position);
+    item->setSize(QSizeF(100, 100));
+    return item;
+}
+
+void ImageUploadSchedulerTest::schedule(QQuickItem *item, const QString &name)
+{
+    m_scheduler->schedule(item, [this, name]() {
+        m_uploads.append(name);
+    });
+}
+
+void ImageUploadSchedulerTest::processFrame()
+{
+    Q_EMIT m_window->afterAnimating();
+}
+
+void ImageUploadSchedulerTest::instance()
+{
+    QCOMPARE(ImageUploadScheduler::instance(m_window), m_scheduler);
+    QCOMPARE(m_scheduler->bytesPerFrame(), ImageUploadScheduler::DefaultBytesPerFrame);
+
+    QQuickWindow other;
+    QVERIFY(ImageUploadScheduler::instance(&other) != m_scheduler);
+}
+
+void ImageUploadSchedulerTest::budget()
+{
+    m_scheduler->setBytesPerFrame(100000);
+    schedule(createItem(), QStringLiteral("a"));
+    schedule(createItem(), QStringLiteral("b"));
+    schedule(createItem(), QStringLiteral("c"));
+    QVERIFY(m_uploads.isEmpty());
+
+    // Two textures fit in the budget, the third waits for the next frame
+    processFrame();
+    QCOMPARE(m_uploads.size(), 2);
+    processFrame();
+    QCOMPARE(m_uploads.size(), 3);
+    processFrame();
+    QCOMPARE(m_uploads.size(), 3);
+}
+
+void ImageUploadSchedulerTest::largestVisibleFirst()
+{
+    m_scheduler->setBytesPerFrame(1);
+    schedule(createItem(QPointF(-50, 0)), QStringLiteral("half"));
+    schedule(createItem(QPointF(300, 300)), QStringLiteral("hidden"));
+    schedule(createItem(QPointF(50, 50)), QStringLiteral("whole"));
+    QQuickItem *invisible = createItem();
+    invisible->setVisible(false);
+    schedule(invisible, QStringLiteral("invisible"));
+
+    for (int i = 0; i < 4; ++i) {
+        processFrame();
+    }
+    QCOMPARE(m_uploads.size(), 4);
+    QCOMPARE(m_uploads.mid(0, 2), (QStringList{QStringLiteral("whole"), QStringLiteral("half")}));
+}
+
+void ImageUploadSchedulerTest::oversizedItem()
+{
+    m_scheduler->setBytesPerFrame(1000);
+    schedule(createItem(), QStringLiteral("a"));
+    schedule(createItem(), QStringLiteral("b"));
+
+    // Still one per frame
+    processFrame();
+    QCOMPARE(m_uploads.size(), 1);
+    processFrame();
+    QCOMPARE(m_uploads.size(), 2);
+}
+
+void ImageUploadSchedulerTest::replace()
+{
+    QQuickItem *item = createItem();
+    schedule(item, QStringLiteral("old"));
+    schedule(item, QStringLiteral("new"));
+
+    processFrame();
+    QCOMPARE(m_uploads, QStringList{QStringLiteral("new")});
+}
+
+void ImageUploadSchedulerTest::cancel()
+{
+    QQuickItem *item = createItem();
+    schedule(item, QStringLiteral("a"));
+    m_scheduler->cancel(item);
+
+    processFrame();
+    QVERIFY(m_uploads.isEmpty());
+}
+
+void ImageUploadSchedulerTest::deletedItem()
+{
+    QQuickItem *item = createItem();
+    schedule(item, QStringLiteral("deleted"));
+    schedule(createItem(), QStringLiteral("alive"));
+    delete item;
+
+    processFrame();
+    QCOMPARE(m_uploads, QStringList{QStringLiteral("alive")});
+
+    // Items moved to another window belong to its scheduler
+    QQuickWindow other;
+    QQuickItem *moved = createItem();
+    schedule(moved, QStringLiteral("moved"));
+    moved->setParentItem(other.contentItem());
+    processFrame();
+    QCOMPARE(m_uploads, QStringList{QStringLiteral("alive")});
+}
+
+QTEST_MAIN(ImageUploadSchedulerTest)
+
+#include "imageuploadschedulertest.moc"
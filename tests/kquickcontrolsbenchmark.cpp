@@ -0,0 +1,230 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QSet>
+#include <QTest>
+
+#include <algorithm>
+#include <memory>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#if __GLIBC_PREREQ(2, 33)
+#define HAVE_MALLINFO2 1
+#endif
+#endif
+
+/**
+ * Measures how the cost of the controls scales with the number of instances.
+ *
+ * The modules are looked up in the QML output directory of the build first,
+ * then in the usual QML import paths.
+ */
+class KQuickControlsBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void initMain()
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+private Q_SLOTS:
+    void initTestCase();
+    void creation_data();
+    void creation();
+    void firstFrame_data();
+    void firstFrame();
+    void objects_data();
+    void objects();
+    void heap_data();
+    void heap();
+
+private:
+    void addRows();
+    // Compiles count instances of the element, null if the modules can't be loaded
+    std::unique_ptr<QQmlComponent> component(const QString &element, int count);
+
+    QQmlEngine m_engine;
+};
+
+void KQuickControlsBenchmark::initTestCase()
+{
+    // Measure the modules just built rather than whichever are installed
+    m_engine.addImportPath(QStringLiteral(QML_OUTPUT_DIRECTORY));
+}
+
+void KQuickControlsBenchmark::addRows()
+{
+    QTest::addColumn<QString>("element");
+    QTest::addColumn<int>("count");
+
+    const QStringList elements{
+        QStringLiteral("KeySequenceItem {}"),
+        QStringLiteral("ColorButton {}"),
+        QStringLiteral("KQuickControlsAddons.QImageItem { width: 16; height: 16 }"),
+        QStringLiteral("KQuickControlsAddons.QPixmapItem { width: 16; height: 16 }"),
+        QStringLiteral("KQuickControlsAddons.MouseEventListener { width: 16; height: 16 }"),
+        QStringLiteral("KQuickControlsAddons.PassiveMouseEventListener { width: 16; height: 16 }"),
+    };
+    for (const QString &element : elements) {
+        const QString name = element.section(QLatin1Char(' '), 0, 0).section(QLatin1Char('.'), -1);
+        for (int count : {10, 100, 1000}) {
+            QTest::addRow("%s %d", qPrintable(name), count) << element << count;
+        }
+    }
+}
+
+std::unique_ptr<QQmlComponent> KQuickControlsBenchmark::component(const QString &element, int count)
+{
+    const QString source = QStringLiteral(
+                               "import QtQuick\n"
+                               "import org.kde.kquickcontrols\n"
+                               "import org.kde.kquickcontrolsaddons as KQuickControlsAddons\n"
+                               "Column { Repeater { model: %1; delegate: %2 } }\n")
+                               .arg(count)
+                               .arg(element);
+
+    auto component = std::make_unique<QQmlComponent>(&m_engine);
+    component->setData(source.toUtf8(), QUrl());
+    return component;
+}
+
+void KQuickControlsBenchmark::creation_data()
+{
+    addRows();
+}
+
+void KQuickControlsBenchmark::creation()
+{
+    QFETCH(QString, element);
+    QFETCH(int, count);
+
+    auto component = this->component(element, count);
+    QVERIFY2(!component->isError(), qPrintable(component->errorString()));
+
+    QBENCHMARK {
+        std::unique_ptr<QObject> root(component->create());
+        QVERIFY(root);
+    }
+}
+
+void KQuickControlsBenchmark::firstFrame_data()
+{
+    addRows();
+}
+
+void KQuickControlsBenchmark::firstFrame()
+{
+    QFETCH(QString, element);
+    QFETCH(int, count);
+
+    auto component = this->component(element, count);
+    QVERIFY2(!component->isError(), qPrintable(component->errorString()));
+
+    // Each frame is the first one of a fresh window, a single one is too noisy to compare
+    constexpr int rounds = 9;
+    QList<qint64> times;
+    times.reserve(rounds);
+    for (int i = 0; i < rounds; ++i) {
+        QQuickWindow window;
+        window.resize(800, 600);
+        std::unique_ptr<QObject> root(component->create());
+        auto item = qobject_cast<QQuickItem *>(root.get());
+        QVERIFY(item);
+        item->setParentItem(window.contentItem());
+
+        // Grabbing renders synchronously: polish, sync and render of the whole scene
+        QElapsedTimer timer;
+        timer.start();
+        const QImage frame = window.grabWindow();
+        times.append(timer.nsecsElapsed());
+        QVERIFY(!frame.isNull());
+    }
+
+    std::nth_element(times.begin(), times.begin() + rounds / 2, times.end());
+    QTest::setBenchmarkResult(times.at(rounds / 2) / 1e6, QTest::WalltimeMilliseconds);
+}
+
+void KQuickControlsBenchmark::objects_data()
+{
+    addRows();
+}
+
+void KQuickControlsBenchmark::objects()
+{
+    QFETCH(QString, element);
+    QFETCH(int, count);
+
+    auto component = this->component(element, count);
+    QVERIFY2(!component->isError(), qPrintable(component->errorString()));
+
+    std::unique_ptr<QObject> root(component->create());
+    QVERIFY(root);
+
+    // Objects reachable through the object and the visual item trees, they don't always coincide
+    QSet<QObject *> objects;
+    QList<QObject *> pending{root.get()};
+    while (!pending.isEmpty()) {
+        QObject *object = pending.takeLast();
+        if (objects.contains(object)) {
+            continue;
+        }
+        objects.insert(object);
+        pending.append(object->children());
+        if (auto item = qobject_cast<QQuickItem *>(object)) {
+            const auto childItems = item->childItems();
+            for (QQuickItem *child : childItems) {
+                pending.append(child);
+            }
+        }
+    }
+
+    // Objects per instance
+    QTest::setBenchmarkResult(qreal(objects.size()) / count, QTest::Events);
+}
+
+void KQuickControlsBenchmark::heap_data()
+{
+    addRows();
+}
+
+void KQuickControlsBenchmark::heap()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(QString, element);
+    QFETCH(int, count);
+
+    auto component = this->component(element, count);
+    QVERIFY2(!component->isError(), qPrintable(component->errorString()));
+
+    // Not counting the types and caches created by the first instances
+    {
+        std::unique_ptr<QObject> warmup(component->create());
+    }
+
+    const size_t before = mallinfo2().uordblks;
+    std::unique_ptr<QObject> root(component->create());
+    QVERIFY(root);
+    const size_t after = mallinfo2().uordblks;
+
+    // Bytes per instance
+    QTest::setBenchmarkResult(after > before ? qreal(after - before) / count : 0, QTest::BytesAllocated);
+#else
+    QSKIP("Measuring the heap needs mallinfo2()");
+#endif
+}
+
+QTEST_MAIN(KQuickControlsBenchmark)
+
+#include "kquickcontrolsbenchmark.moc"
@@ -0,0 +1,216 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passivemouseeventlistener.h"
+
+#include <QQuickWindow>
+#include <QSignalSpy>
+#include <QTest>
+
+// Takes the presses delivered to it, like a MouseArea
+class PressTarget : public QQuickItem
+{
+public:
+    explicit PressTarget(QQuickItem *parent)
+        : QQuickItem(parent)
+    {
+        setAcceptedMouseButtons(Qt::LeftButton);
+    }
+
+    int presses = 0;
+
+protected:
+    void mousePressEvent(QMouseEvent *event) override
+    {
+        ++presses;
+        event->accept();
+    }
+};
+
+class PassiveMouseEventListenerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+    void pressOnChild();
+    void acceptedPress();
+    void occludedPress();
+    void occludedAcceptedPress();
+    void nestedListeners();
+    void clippedListener();
+    void hover();
+
+private:
+    QQuickWindow *m_window = nullptr;
+    PassiveMouseEventListener *m_listener = nullptr;
+    PressTarget *m_child = nullptr;
+};
+
+void PassiveMouseEventListenerTest::init()
+{
+    m_window = new QQuickWindow;
+    m_window->resize(200, 200);
+
+    m_listener = new PassiveMouseEventListener(m_window->contentItem());
+    m_listener->setSize(QSizeF(100, 100));
+    m_child = new PressTarget(m_listener);
+    m_child->setSize(QSizeF(100, 100));
+
+    m_window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_window));
+}
+
+void PassiveMouseEventListenerTest::cleanup()
+{
+    delete m_window;
+    m_window = nullptr;
+}
+
+void PassiveMouseEventListenerTest::pressOnChild()
+{
+    QSignalSpy pressed(m_listener, &PassiveMouseEventListener::pressed);
+    QSignalSpy released(m_listener, &PassiveMouseEventListener::released);
+
+    QTest::mousePress(m_window, Qt::LeftButton, {}, QPoint(50, 50));
+    QCOMPARE(pressed.count(), 1);
+    QVERIFY(m_listener->isPressed());
+    // Observed, not taken
+    QCOMPARE(m_child->presses, 1);
+
+    // Followed outside of the item until the release
+    QTest::mouseRelease(m_window, Qt::LeftButton, {}, QPoint(150, 150));
+    QCOMPARE(released.count(), 1);
+    QVERIFY(!m_listener->isPressed());
+
+    // Outside of the item
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(150, 150));
+    QCOMPARE(pressed.count(), 1);
+}
+
+void PassiveMouseEventListenerTest::acceptedPress()
+{
+    connect(m_listener, &PassiveMouseEventListener::pressed, this, [](KDeclarativeMouseEvent *event) {
+        event->setAccepted(true);
+    });
+
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(50, 50));
+    QCOMPARE(m_child->presses, 0);
+}
+
+void PassiveMouseEventListenerTest::occludedPress()
+{
+    // A sibling stacked above the listener
+    auto *occluder = new PressTarget(m_window->contentItem());
+    occluder->setPosition(QPointF(50, 50));
+    occluder->setSize(QSizeF(100, 100));
+
+    QSignalSpy pressed(m_listener, &PassiveMouseEventListener::pressed);
+
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(75, 75));
+    QCOMPARE(pressed.count(), 0);
+    QVERIFY(!m_listener->isPressed());
+    QCOMPARE(occluder->presses, 1);
+    QCOMPARE(m_child->presses, 0);
+
+    // The part of the listener which isn't covered
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(25, 25));
+    QCOMPARE(pressed.count(), 1);
+    QCOMPARE(m_child->presses, 1);
+
+    // Stacked below the listener, the sibling doesn't hide it anymore
+    occluder->setZ(-1);
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(75, 75));
+    QCOMPARE(pressed.count(), 2);
+    QCOMPARE(occluder->presses, 1);
+}
+
+void PassiveMouseEventListenerTest::occludedAcceptedPress()
+{
+    auto *occluder = new PressTarget(m_window->contentItem());
+    occluder->setSize(QSizeF(100, 100));
+
+    // Accepting would eat the press, if it reached the listener
+    connect(m_listener, &PassiveMouseEventListener::pressed, this, [](KDeclarativeMouseEvent *event) {
+        event->setAccepted(true);
+    });
+    QSignalSpy pressed(m_listener, &PassiveMouseEventListener::pressed);
+
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(50, 50));
+    QCOMPARE(pressed.count(), 0);
+    QCOMPARE(occluder->presses, 1);
+}
+
+void PassiveMouseEventListenerTest::nestedListeners()
+{
+    // Both listeners see presses on the inner one, only the outer one sees presses on the rest
+    auto *inner = new PassiveMouseEventListener(m_child);
+    inner->setSize(QSizeF(50, 50));
+    auto *innerChild = new PressTarget(inner);
+    innerChild->setSize(QSizeF(50, 50));
+
+    QSignalSpy outerPressed(m_listener, &PassiveMouseEventListener::pressed);
+    QSignalSpy innerPressed(inner, &PassiveMouseEventListener::pressed);
+
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(25, 25));
+    QCOMPARE(outerPressed.count(), 1);
+    QCOMPARE(innerPressed.count(), 1);
+    QCOMPARE(innerChild->presses, 1);
+
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(75, 75));
+    QCOMPARE(outerPressed.count(), 2);
+    QCOMPARE(innerPressed.count(), 1);
+    QCOMPARE(m_child->presses, 1);
+
+    // The outer listener accepting hides the press from the inner one
+    connect(m_listener, &PassiveMouseEventListener::pressed, this, [](KDeclarativeMouseEvent *event) {
+        event->setAccepted(true);
+    });
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(25, 25));
+    QCOMPARE(outerPressed.count(), 3);
+    QCOMPARE(innerPressed.count(), 1);
+    QCOMPARE(innerChild->presses, 1);
+}
+
+void PassiveMouseEventListenerTest::clippedListener()
+{
+    // Only the top left quarter of the listener is visible
+    auto *clipper = new QQuickItem(m_window->contentItem());
+    clipper->setSize(QSizeF(50, 50));
+    clipper->setClip(true);
+    m_listener->setParentItem(clipper);
+
+    QSignalSpy pressed(m_listener, &PassiveMouseEventListener::pressed);
+
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(75, 75));
+    QCOMPARE(pressed.count(), 0);
+
+    QTest::mouseClick(m_window, Qt::LeftButton, {}, QPoint(25, 25));
+    QCOMPARE(pressed.count(), 1);
+}
+
+void PassiveMouseEventListenerTest::hover()
+{
+    QSignalSpy positionChanged(m_listener, &PassiveMouseEventListener::positionChanged);
+
+    // Not followed without hoverEnabled
+    QTest::mouseMove(m_window, QPoint(50, 50));
+    QCOMPARE(positionChanged.count(), 0);
+    QVERIFY(!m_listener->containsMouse());
+
+    m_listener->setHoverEnabled(true);
+    QTest::mouseMove(m_window, QPoint(60, 60));
+    QCOMPARE(positionChanged.count(), 1);
+    QVERIFY(m_listener->containsMouse());
+
+    QTest::mouseMove(m_window, QPoint(150, 150));
+    QVERIFY(!m_listener->containsMouse());
+}
+
+QTEST_MAIN(PassiveMouseEventListenerTest)
+
+#include "passivemouseeventlistenertest.moc"
@@ -0,0 +1,259 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "qimageitem.h"
+
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSignalSpy>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+
+class QImageItemAutoTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void initMain()
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+        // Grabbing the window reads back what the item rendered
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    }
+
+private Q_SLOTS:
+    void selectSource_data();
+    void selectSource();
+    void presentFrame();
+    void presentFrameFromThread();
+    void orientation_data();
+    void orientation();
+    void colors();
+
+private:
+    // A shown 100x100 window filled by a QImageItem
+    std::unique_ptr<QQuickWindow> createWindow(QImageItem **item);
+};
+
+static QImage filled(const QSize &size, const QColor &color)
+{
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(color);
+    return image;
+}
+
+// Red, green, blue and yellow quadrants from the top left, in reading order
+static QImage quadrants()
+{
+    QImage image(40, 20, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    QPainter painter(&image);
+    painter.fillRect(20, 0, 20, 10, Qt::green);
+    painter.fillRect(0, 10, 20, 10, Qt::blue);
+    painter.fillRect(20, 10, 20, 10, Qt::yellow);
+    return image;
+}
+
+std::unique_ptr<QQuickWindow> QImageItemAutoTest::createWindow(QImageItem **item)
+{
+    auto window = std::make_unique<QQuickWindow>();
+    window->resize(100, 100);
+    *item = new QImageItem(window->contentItem());
+    (*item)->setSize(QSizeF(100, 100));
+    window->show();
+    if (!QTest::qWaitForWindowExposed(window.get())) {
+        return nullptr;
+    }
+    return window;
+}
+
+// An entry of sources, the properties which are 0 are left out
+static QVariantMap entry(const QString &source, qreal scale, int width = 0)
+{
+    QVariantMap map{{QStringLiteral("source"), QUrl(source)}};
+    if (scale) {
+        map.insert(QStringLiteral("scale"), scale);
+    }
+    if (width) {
+        map.insert(QStringLiteral("width"), width);
+    }
+    return map;
+}
+
+void QImageItemAutoTest::selectSource_data()
+{
+    QTest::addColumn<QVariantList>("sources");
+    QTest::addColumn<qreal>("dpr");
+    QTest::addColumn<qreal>("width");
+    QTest::addColumn<QUrl>("source");
+    QTest::addColumn<qreal>("scale");
+
+    const QVariantList scales{entry(QStringLiteral("a.png"), 1), entry(QStringLiteral("a@2x.png"), 2), entry(QStringLiteral("a@3x.png"), 3)};
+    QTest::newRow("exact scale") << scales << 2.0 << 100.0 << QUrl(QStringLiteral("a@2x.png")) << 2.0;
+    QTest::newRow("smallest sharp scale") << scales << 1.5 << 100.0 << QUrl(QStringLiteral("a@2x.png")) << 2.0;
+    QTest::newRow("largest scale") << scales << 4.0 << 100.0 << QUrl(QStringLiteral("a@3x.png")) << 3.0;
+    QTest::newRow("default scale") << QVariantList{entry(QStringLiteral("a.png"), 0), entry(QStringLiteral("a@2x.png"), 2)} << 1.0 << 100.0
+                                   << QUrl(QStringLiteral("a.png")) << 1.0;
+    QTest::newRow("invalid entries") << QVariantList{entry(QString(), 1), entry(QStringLiteral("a.png"), -1), entry(QStringLiteral("b.png"), 2)} << 1.0
+                                     << 100.0 << QUrl(QStringLiteral("b.png")) << 2.0;
+    QTest::newRow("empty") << QVariantList() << 1.0 << 100.0 << QUrl() << 0.0;
+
+    const QVariantList widths{entry(QStringLiteral("b-1920.jpg"), 0, 1920), entry(QStringLiteral("b-640.jpg"), 0, 640)};
+    QTest::newRow("narrowest covering width") << widths << 2.0 << 300.0 << QUrl(QStringLiteral("b-640.jpg")) << 2.0;
+    QTest::newRow("exact width") << widths << 1.0 << 640.0 << QUrl(QStringLiteral("b-640.jpg")) << 1.0;
+    QTest::newRow("wider in device pixels") << widths << 2.0 << 400.0 << QUrl(QStringLiteral("b-1920.jpg")) << 2.0;
+    QTest::newRow("widest width") << widths << 2.0 << 1200.0 << QUrl(QStringLiteral("b-1920.jpg")) << 2.0;
+    QTest::newRow("given scale") << QVariantList{entry(QStringLiteral("c-640.jpg"), 1, 640), entry(QStringLiteral("c-1280.jpg"), 1, 1280)} << 2.0 << 400.0
+                                 << QUrl(QStringLiteral("c-1280.jpg")) << 1.0;
+    // Without a width to cover, or without the widths of all entries, by scale
+    QTest::newRow("no item width") << QVariantList{entry(QStringLiteral("d-640.jpg"), 1, 640), entry(QStringLiteral("d-1280.jpg"), 2, 1280)} << 2.0 << 0.0
+                                   << QUrl(QStringLiteral("d-1280.jpg")) << 2.0;
+    QTest::newRow("missing width") << QVariantList{entry(QStringLiteral("e-640.jpg"), 1, 640), entry(QStringLiteral("e@2x.jpg"), 2)} << 1.0 << 1000.0
+                                   << QUrl(QStringLiteral("e-640.jpg")) << 1.0;
+}
+
+void QImageItemAutoTest::selectSource()
+{
+    QFETCH(QVariantList, sources);
+    QFETCH(qreal, dpr);
+    QFETCH(qreal, width);
+    QFETCH(QUrl, source);
+    QFETCH(qreal, scale);
+
+    const auto selected = QImageItem::selectSource(sources, dpr, width);
+    QCOMPARE(selected.first, source);
+    QCOMPARE(selected.second, scale);
+}
+
+void QImageItemAutoTest::presentFrame()
+{
+    QImageItem *item;
+    const auto window = createWindow(&item);
+    QVERIFY(window);
+    QSignalSpy nullChanged(item, &QImageItem::nullChanged);
+    QSignalSpy nativeWidthChanged(item, &QImageItem::nativeWidthChanged);
+
+    // Not rendered yet when the next one arrives, so dropped
+    item->presentFrame(filled(QSize(50, 50), Qt::red));
+    item->presentFrame(filled(QSize(80, 40), Qt::blue));
+
+    QTRY_COMPARE(window->grabWindow().pixelColor(50, 50), QColor(Qt::blue));
+    QCOMPARE(item->image().size(), QSize(80, 40));
+    QTRY_COMPARE(nativeWidthChanged.count(), 1);
+    QCOMPARE(item->nativeWidth(), 80);
+    QCOMPARE(nullChanged.count(), 1);
+    QVERIFY(!item->isNull());
+
+    // Frames of the same size don't notify anything
+    item->presentFrame(filled(QSize(80, 40), Qt::green));
+    QTRY_COMPARE(window->grabWindow().pixelColor(50, 50), QColor(Qt::green));
+    QCOMPARE(nativeWidthChanged.count(), 1);
+}
+
+void QImageItemAutoTest::presentFrameFromThread()
+{
+    QImageItem *item;
+    const auto window = createWindow(&item);
+    QVERIFY(window);
+
+    std::unique_ptr<QThread> producer(QThread::create([item]() {
+        for (int i = 0; i < 100; ++i) {
+            item->presentFrame(filled(QSize(10, 10), i < 99 ? Qt::red : Qt::green));
+        }
+    }));
+    producer->start();
+    QVERIFY(producer->wait(5000));
+
+    // Whichever frames got rendered in between, the last one stays
+    QTRY_COMPARE(window->grabWindow().pixelColor(50, 50), QColor(Qt::green));
+    QCOMPARE(item->image().pixelColor(0, 0), QColor(Qt::green));
+}
+
+void QImageItemAutoTest::orientation_data()
+{
+    QTest::addColumn<int>("orientation");
+    QTest::addColumn<QSize>("nativeSize");
+    // The quadrants of the image as shown, in reading order
+    QTest::addColumn<QList<QColor>>("colors");
+
+    const QColor r = Qt::red;
+    const QColor g = Qt::green;
+    const QColor b = Qt::blue;
+    const QColor y = Qt::yellow;
+    QTest::newRow("1 upright") << 1 << QSize(40, 20) << QList<QColor>{r, g, b, y};
+    QTest::newRow("2 mirrored") << 2 << QSize(40, 20) << QList<QColor>{g, r, y, b};
+    QTest::newRow("3 rotated by 180") << 3 << QSize(40, 20) << QList<QColor>{y, b, g, r};
+    QTest::newRow("4 flipped") << 4 << QSize(40, 20) << QList<QColor>{b, y, r, g};
+    QTest::newRow("5 transposed") << 5 << QSize(20, 40) << QList<QColor>{r, b, g, y};
+    QTest::newRow("6 rotated clockwise") << 6 << QSize(20, 40) << QList<QColor>{b, r, y, g};
+    QTest::newRow("7 transversed") << 7 << QSize(20, 40) << QList<QColor>{y, g, b, r};
+    QTest::newRow("8 rotated counterclockwise") << 8 << QSize(20, 40) << QList<QColor>{g, y, r, b};
+}
+
+void QImageItemAutoTest::orientation()
+{
+    QFETCH(int, orientation);
+    QFETCH(QSize, nativeSize);
+    QFETCH(QList<QColor>, colors);
+
+    QImageItem *item;
+    const auto window = createWindow(&item);
+    QVERIFY(window);
+    item->setImage(quadrants());
+    item->setOrientation(orientation);
+
+    QCOMPARE(item->orientation(), orientation);
+    QCOMPARE(QSize(item->nativeWidth(), item->nativeHeight()), nativeSize);
+    // The pixels in memory are left alone
+    QCOMPARE(item->image().size(), QSize(40, 20));
+
+    // Stretched, with the transform of the node
+    const QList<QPoint> stretched{{25, 25}, {75, 25}, {25, 75}, {75, 75}};
+    for (int i = 0; i < colors.size(); ++i) {
+        QTRY_COMPARE(window->grabWindow().pixelColor(stretched[i]), colors[i]);
+    }
+
+    // Tiled, at the native size with the painter
+    item->setFillMode(QImageItem::Tile);
+    const int w = nativeSize.width() / 4;
+    const int h = nativeSize.height() / 4;
+    const QList<QPoint> tiled{{w, h}, {3 * w, h}, {w, 3 * h}, {3 * w, 3 * h}};
+    for (int i = 0; i < colors.size(); ++i) {
+        QTRY_COMPARE(window->grabWindow().pixelColor(tiled[i]), colors[i]);
+    }
+}
+
+void QImageItemAutoTest::colors()
+{
+    QImageItem item;
+    QSignalSpy colorsChanged(&item, &QImageItem::colorsChanged);
+
+    // Three quarters blue, one quarter red
+    QImage image = filled(QSize(40, 40), Qt::blue);
+    QPainter(&image).fillRect(0, 0, 40, 10, Qt::red);
+    item.setImage(image);
+
+    // Computed on first use, meanwhile invalid
+    QVERIFY(!item.dominantColor().isValid());
+    QVERIFY(colorsChanged.wait());
+    QCOMPARE(item.dominantColor().name(), QColor(4, 4, 252).name());
+    QCOMPARE(item.averageColor().name(), QColor(63, 0, 191).name());
+    const QVariantList palette = item.palette();
+    QCOMPARE(palette.size(), 2);
+    QCOMPARE(palette.at(1).value<QColor>().name(), QColor(252, 4, 4).name());
+
+    // And again for every new image once used
+    item.setImage(filled(QSize(40, 40), Qt::green));
+    QVERIFY(colorsChanged.wait());
+    QCOMPARE(item.dominantColor().name(), QColor(4, 252, 4).name());
+    QCOMPARE(item.palette().size(), 1);
+}
+
+QTEST_MAIN(QImageItemAutoTest)
+
+#include "qimageitemautotest.moc"
@@ -17,15 +17,9 @@ int main(int argc, char *argv[])
     QQuickView view;
     QQmlContext *context = view.rootContext();
 
-    QImage image;
-    if (app.devicePixelRatio() < 2) {
-        image = QImage(QFINDTESTDATA("testimage.png"));
-    } else {
-        image = QImage(QFINDTESTDATA("testimage@2x.png"));
-        image.setDevicePixelRatio(2);
-    }
-
-    context->setContextProperty(QStringLiteral("testImage"), image);
+    // QImageItem picks the variant matching the device pixel ratio of the screen
+    context->setContextProperty(QStringLiteral("testImageSource"), QUrl::fromLocalFile(QFINDTESTDATA("testimage.png")));
+    context->setContextProperty(QStringLiteral("testImage2xSource"), QUrl::fromLocalFile(QFINDTESTDATA("testimage@2x.png")));
 
     view.setSource(QUrl::fromLocalFile(QFINDTESTDATA("qimageitemtest.qml")));
     view.show();
@@ -18,7 +18,10 @@ Rectangle {
             implicitHeight: 300
 
             id: image
-            image: testImage
+            sources: [
+                { source: testImageSource, scale: 1 },
+                { source: testImage2xSource, scale: 2 },
+            ]
             fillMode: fillModeCombo.currentIndex
         }
         GridLayout {
@@ -0,0 +1,255 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "sharedeventsnapshot.h"
+
+#include <QCoreApplication>
+#include <QSharedMemory>
+#include <QTest>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+using namespace CalendarEvents;
+
+class SharedEventSnapshotTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void roundTrip();
+    void sequence();
+    void forEachEvent();
+    void publishTooLarge();
+    void readerOnly();
+    void secondOwner();
+    void segmentTooSmall();
+    void badHeader();
+    void corruptHeader();
+
+private:
+    QString key(const char *name) const;
+};
+
+QString SharedEventSnapshotTest::key(const char *name) const
+{
+    // Unique per run, so a crashed run can't leave a segment behind for the next one
+    return QStringLiteral("sharedeventsnapshottest-%1-%2").arg(QCoreApplication::applicationPid()).arg(QLatin1String(name));
+}
+
+static EventData event(const QString &title, const QDateTime &start, const QDateTime &end)
+{
+    EventData event;
+    event.setTitle(title);
+    event.setDescription(QStringLiteral("Description of ") + title);
+    event.setUid(QStringLiteral("uid-") + title);
+    event.setEventColor(QStringLiteral("#ff8800"));
+    event.setStartDateTime(start);
+    event.setEndDateTime(end);
+    return event;
+}
+
+static void compareEvents(const EventData &actual, const EventData &expected)
+{
+    QCOMPARE(actual.title(), expected.title());
+    QCOMPARE(actual.description(), expected.description());
+    QCOMPARE(actual.uid(), expected.uid());
+    QCOMPARE(actual.eventColor(), expected.eventColor());
+    QCOMPARE(actual.type(), expected.type());
+    QCOMPARE(actual.isAllDay(), expected.isAllDay());
+    QCOMPARE(actual.isMinor(), expected.isMinor());
+    QCOMPARE(actual.startDateTime(), expected.startDateTime());
+    QCOMPARE(actual.startDateTime().timeSpec(), expected.startDateTime().timeSpec());
+    QCOMPARE(actual.endDateTime(), expected.endDateTime());
+    QCOMPARE(actual.endDateTime().timeSpec(), expected.endDateTime().timeSpec());
+}
+
+void SharedEventSnapshotTest::roundTrip()
+{
+    const QDate day(2026, 3, 14);
+    const QTimeZone berlin("Europe/Berlin");
+
+    EventData zoned = event(QStringLiteral("zoned"), QDateTime(day, QTime(10, 0), berlin), QDateTime(day, QTime(11, 30), berlin));
+    EventData utc = event(QStringLiteral("utc"), QDateTime(day, QTime(8, 0), QTimeZone::UTC), QDateTime(day, QTime(9, 0), QTimeZone::UTC));
+    utc.setIsMinor(true);
+    EventData local = event(QStringLiteral("local"), QDateTime(day, QTime(12, 0)), QDateTime());
+    local.setEventType(EventData::Todo);
+    EventData allDay = event(QStringLiteral("all day"), QDateTime(day, QTime(0, 0)), QDateTime(day.addDays(1), QTime(0, 0)));
+    allDay.setIsAllDay(true);
+    allDay.setEventType(EventData::Holiday);
+    allDay.setDescription(QString());
+
+    QMultiHash<QDate, EventData> data;
+    data.insert(day, zoned);
+    data.insert(day, utc);
+    data.insert(day, local);
+    data.insert(day, allDay);
+    data.insert(day.addDays(1), allDay);
+
+    SharedEventSnapshot owner(key("roundTrip"), SharedEventSnapshot::Owner);
+    QVERIFY2(owner.isValid(), qPrintable(owner.errorString()));
+    QVERIFY2(owner.publish(data, day.addDays(-7), day.addDays(7)), qPrintable(owner.errorString()));
+
+    SharedEventSnapshot reader(key("roundTrip"));
+    QVERIFY2(reader.isValid(), qPrintable(reader.errorString()));
+
+    const SharedEventSnapshot::Batch batch = reader.read();
+    QCOMPARE(batch.sequence, quint64(1));
+    QCOMPARE(batch.startDate, day.addDays(-7));
+    QCOMPARE(batch.endDate, day.addDays(7));
+    QCOMPARE(batch.data.size(), data.size());
+    QCOMPARE(batch.data.values(day).size(), 4);
+    QCOMPARE(batch.data.values(day.addDays(1)).size(), 1);
+
+    const auto events = batch.data.values(day);
+    for (const EventData &expected : {zoned, utc, local, allDay}) {
+        auto it = std::find_if(events.begin(), events.end(), [&expected](const EventData &event) {
+            return event.title() == expected.title();
+        });
+        QVERIFY2(it != events.end(), qPrintable(expected.title()));
+        compareEvents(*it, expected);
+    }
+    compareEvents(batch.data.value(day.addDays(1)), allDay);
+}
+
+void SharedEventSnapshotTest::sequence()
+{
+    SharedEventSnapshot owner(key("sequence"), SharedEventSnapshot::Owner);
+    SharedEventSnapshot reader(key("sequence"));
+    QCOMPARE(reader.sequence(), quint64(0));
+
+    const QDate day(2026, 1, 1);
+    QVERIFY(owner.publish({}, day, day));
+    QCOMPARE(reader.sequence(), quint64(1));
+    QVERIFY(owner.publish({{day, event(QStringLiteral("one"), QDateTime(day, QTime(9, 0)), QDateTime())}}, day, day));
+    QCOMPARE(reader.sequence(), quint64(2));
+    QCOMPARE(reader.read().data.size(), 1);
+}
+
+void SharedEventSnapshotTest::forEachEvent()
+{
+    SharedEventSnapshot owner(key("forEachEvent"), SharedEventSnapshot::Owner);
+    SharedEventSnapshot reader(key("forEachEvent"));
+
+    const QDate day(2026, 1, 1);
+    QMultiHash<QDate, EventData> data;
+    data.insert(day, event(QStringLiteral("one"), QDateTime(day, QTime(9, 0)), QDateTime()));
+    data.insert(day.addDays(1), event(QStringLiteral("two"), QDateTime(day.addDays(1), QTime(9, 0)), QDateTime()));
+    QVERIFY(owner.publish(data, day, day.addDays(1)));
+
+    // Only the events of one day are kept
+    QList<EventData> events;
+    const quint64 sequence = reader.forEachEvent([&](const QDate &eventDay, const EventData &event) {
+        if (eventDay == day.addDays(1)) {
+            events.append(event);
+        }
+    });
+    QCOMPARE(sequence, quint64(1));
+    QCOMPARE(events.size(), 1);
+    compareEvents(events.constFirst(), data.value(day.addDays(1)));
+}
+
+void SharedEventSnapshotTest::publishTooLarge()
+{
+    // Room for the header, but not for a single record
+    SharedEventSnapshot owner(key("publishTooLarge"), SharedEventSnapshot::Owner, 64);
+    QVERIFY2(owner.isValid(), qPrintable(owner.errorString()));
+
+    const QDate day(2026, 1, 1);
+    QVERIFY(!owner.publish({{day, event(QStringLiteral("one"), QDateTime(day, QTime(9, 0)), QDateTime())}}, day, day));
+    QVERIFY(!owner.errorString().isEmpty());
+
+    SharedEventSnapshot reader(key("publishTooLarge"));
+    QCOMPARE(reader.sequence(), quint64(0));
+    QVERIFY(reader.read().data.isEmpty());
+}
+
+void SharedEventSnapshotTest::readerOnly()
+{
+    SharedEventSnapshot owner(key("readerOnly"), SharedEventSnapshot::Owner);
+    SharedEventSnapshot reader(key("readerOnly"));
+
+    const QDate day(2026, 1, 1);
+    QVERIFY(!reader.publish({}, day, day));
+    QVERIFY(!reader.errorString().isEmpty());
+    QCOMPARE(reader.sequence(), quint64(0));
+}
+
+void SharedEventSnapshotTest::secondOwner()
+{
+    const QDate day(2026, 1, 1);
+    auto owner = std::make_unique<SharedEventSnapshot>(key("secondOwner"), SharedEventSnapshot::Owner);
+    QVERIFY(owner->publish({{day, event(QStringLiteral("one"), QDateTime(day, QTime(9, 0)), QDateTime())}}, day, day));
+
+    // Doesn't take over, nor reset the batch of the live owner
+    SharedEventSnapshot second(key("secondOwner"), SharedEventSnapshot::Owner);
+    QVERIFY(!second.isValid());
+    QVERIFY(!second.publish({}, day, day));
+    QVERIFY(!second.errorString().isEmpty());
+
+    SharedEventSnapshot reader(key("secondOwner"));
+    QCOMPARE(reader.sequence(), quint64(1));
+    QCOMPARE(reader.read().data.size(), 1);
+
+    // Once the owner is gone the segment is free to take over
+    owner.reset();
+    QVERIFY2(second.publish({}, day, day), qPrintable(second.errorString()));
+    QCOMPARE(reader.sequence(), quint64(2));
+    QVERIFY(reader.read().data.isEmpty());
+}
+
+void SharedEventSnapshotTest::segmentTooSmall()
+{
+    // Smaller than the header of a snapshot
+    QSharedMemory memory(key("segmentTooSmall"));
+    QVERIFY2(memory.create(16), qPrintable(memory.errorString()));
+    std::memset(memory.data(), 0, memory.size());
+
+    SharedEventSnapshot reader(key("segmentTooSmall"));
+    QVERIFY(reader.isValid());
+    QCOMPARE(reader.sequence(), quint64(0));
+    QVERIFY(reader.read().data.isEmpty());
+    QVERIFY(!reader.errorString().isEmpty());
+}
+
+void SharedEventSnapshotTest::badHeader()
+{
+    QSharedMemory memory(key("badHeader"));
+    QVERIFY2(memory.create(4096), qPrintable(memory.errorString()));
+    std::memset(memory.data(), 0xab, memory.size());
+
+    SharedEventSnapshot reader(key("badHeader"));
+    QVERIFY(reader.isValid());
+    QCOMPARE(reader.sequence(), quint64(0));
+    QVERIFY(reader.read().data.isEmpty());
+    QVERIFY(!reader.errorString().isEmpty());
+}
+
+void SharedEventSnapshotTest::corruptHeader()
+{
+    SharedEventSnapshot owner(key("corruptHeader"), SharedEventSnapshot::Owner, 4096);
+    const QDate day(2026, 1, 1);
+    QVERIFY(owner.publish({{day, event(QStringLiteral("one"), QDateTime(day, QTime(9, 0)), QDateTime())}}, day, day));
+
+    // A valid magic and version, but far more records than the segment can hold.
+    // The record count follows magic, version, sequence and the two julian days.
+    QSharedMemory memory(key("corruptHeader"));
+    QVERIFY2(memory.attach(), qPrintable(memory.errorString()));
+    const quint32 recordCount = 0x10000000;
+    std::memcpy(static_cast<char *>(memory.data()) + 32, &recordCount, sizeof(recordCount));
+
+    SharedEventSnapshot reader(key("corruptHeader"));
+    QCOMPARE(reader.sequence(), quint64(1));
+    const SharedEventSnapshot::Batch batch = reader.read();
+    QVERIFY(batch.data.isEmpty());
+    QVERIFY(!reader.errorString().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(SharedEventSnapshotTest)
+
+#include "sharedeventsnapshottest.moc"
@@ -0,0 +1,207 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "allocationcounter.h"
+#include "translationcontext.h"
+
+#include <QTest>
+
+class TranslationContextBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void calls_data();
+    void calls();
+    void allocations_data();
+    void allocations();
+    void domainSwitch();
+    void repeatedLookup();
+    void batch();
+
+private:
+    void addRows();
+
+    TranslationContext m_context;
+};
+
+// Passes visit a callable making just the call of function, the branch and the arguments are resolved up front
+template<typename Visitor>
+static void withCall(const TranslationContext &context,
+                     const QString &function,
+                     const QString &contextString,
+                     const QString &singular,
+                     const QString &plural,
+                     const QStringList &p,
+                     Visitor visit)
+{
+    if (function == QLatin1String("i18n")) {
+        visit([&]() {
+            return context.i18n(singular, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9]);
+        });
+    } else if (function == QLatin1String("i18nc")) {
+        visit([&]() {
+            return context.i18nc(contextString, singular, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9]);
+        });
+    } else if (function == QLatin1String("i18np")) {
+        visit([&]() {
+            return context.i18np(singular, plural, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9]);
+        });
+    } else {
+        visit([&]() {
+            return context.i18ncp(contextString, singular, plural, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9]);
+        });
+    }
+}
+
+// A row calling function with a message taking args
+static void addRow(const char *name, const char *function, const QStringList &args)
+{
+    QString placeholders;
+    for (int i = 1; i <= args.size(); ++i) {
+        placeholders += QLatin1String(" %") + QString::number(i);
+    }
+
+    QStringList params = args;
+    params.resize(10);
+
+    QTest::newRow(name) << QString::fromLatin1(function) << QStringLiteral("@label") << (QStringLiteral("A message") + placeholders)
+                        << (QStringLiteral("Messages") + placeholders) << params;
+}
+
+void TranslationContextBenchmark::initTestCase()
+{
+    m_context.setDomain(QStringLiteral("kdeclarative6"));
+}
+
+void TranslationContextBenchmark::addRows()
+{
+    QTest::addColumn<QString>("function");
+    QTest::addColumn<QString>("contextString");
+    QTest::addColumn<QString>("singular");
+    QTest::addColumn<QString>("plural");
+    // Padded to the ten arguments the functions take
+    QTest::addColumn<QStringList>("params");
+
+    for (const char *function : {"i18n", "i18nc"}) {
+        QStringList args;
+        for (int count = 0; count <= 10; ++count) {
+            addRow(qPrintable(QStringLiteral("%1 %2").arg(QLatin1String(function)).arg(count)), function, args);
+            args.append(QStringLiteral("argument"));
+        }
+    }
+
+    // The first argument of the plural functions is parsed as the number
+    for (const char *function : {"i18np", "i18ncp"}) {
+        QStringList args{QStringLiteral("5")};
+        for (int count = 1; count <= 10; ++count) {
+            addRow(qPrintable(QStringLiteral("%1 %2").arg(QLatin1String(function)).arg(count)), function, args);
+            args.append(QStringLiteral("argument"));
+        }
+        addRow(qPrintable(QStringLiteral("%1 not a number").arg(QLatin1String(function))), function, {QStringLiteral("five")});
+    }
+}
+
+void TranslationContextBenchmark::calls_data()
+{
+    addRows();
+}
+
+void TranslationContextBenchmark::calls()
+{
+    QFETCH(QString, function);
+    QFETCH(QString, contextString);
+    QFETCH(QString, singular);
+    QFETCH(QString, plural);
+    QFETCH(QStringList, params);
+
+    withCall(m_context, function, contextString, singular, plural, params, [](const auto &call) {
+        QVERIFY(!call().isEmpty());
+
+        QBENCHMARK {
+            call();
+        }
+    });
+}
+
+void TranslationContextBenchmark::allocations_data()
+{
+    addRows();
+}
+
+void TranslationContextBenchmark::allocations()
+{
+    QFETCH(QString, function);
+    QFETCH(QString, contextString);
+    QFETCH(QString, singular);
+    QFETCH(QString, plural);
+    QFETCH(QStringList, params);
+
+    if (!AllocationCounter::isAvailable()) {
+        QSKIP("Counting allocations needs glibc");
+    }
+
+    withCall(m_context, function, contextString, singular, plural, params, [](const auto &call) {
+        call();
+
+        constexpr int rounds = 100;
+        const quint64 before = AllocationCounter::count();
+        for (int i = 0; i < rounds; ++i) {
+            call();
+        }
+        const quint64 allocations = AllocationCounter::count() - before;
+
+        // Heap allocations per call, the result string included
+        QTest::setBenchmarkResult(qreal(allocations) / rounds, QTest::Events);
+    });
+}
+
+void TranslationContextBenchmark::domainSwitch()
+{
+    TranslationContext context;
+    const QString first = QStringLiteral("kdeclarative6");
+    const QString second = QStringLiteral("kdeclarative6-benchmark");
+    const QString message = QStringLiteral("A message");
+
+    QBENCHMARK {
+        context.setDomain(first);
+        context.i18n(message);
+        context.setDomain(second);
+        context.i18n(message);
+    }
+}
+
+void TranslationContextBenchmark::repeatedLookup()
+{
+    const QString contextString = QStringLiteral("@info:tooltip");
+    const QString message = QStringLiteral("Clear Key Sequence");
+
+    // The same lookup as many instances of a component evaluating the same binding
+    QBENCHMARK {
+        for (int i = 0; i < 100; ++i) {
+            m_context.i18nc(contextString, message);
+        }
+    }
+}
+
+void TranslationContextBenchmark::batch()
+{
+    QVariantList messages;
+    for (int i = 0; i < 100; ++i) {
+        messages.append(QVariant(QVariantList{QStringLiteral("@label"), QStringLiteral("Row %1"), QString::number(i)}));
+    }
+
+    QCOMPARE(m_context.i18ncBatch(messages).size(), messages.size());
+
+    QBENCHMARK {
+        m_context.i18ncBatch(messages);
+    }
+}
+
+QTEST_MAIN(TranslationContextBenchmark)
+
+#include "translationcontextbenchmark.moc"